@@ -0,0 +1,329 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Times the animation and update path, from a single easing to a whole page.
+//
+// Usage: animation_benchmark [-components N] [-frames N]
+//                            [-dir path -collection name [-layout name]]
+//
+// The easing and tween engine stages run on synthetic tweens. With a RetroFE
+// install, N components also play the animations of the layout's components,
+// and the page is updated and scrolled with and without threading. Every stage
+// prints one JSON object per line so results can be compared between builds.
+
+#include "BenchmarkPage.h"
+#include "../Graphics/Animate/Animation.h"
+#include "../Graphics/Animate/AnimationEvents.h"
+#include "../Graphics/Animate/Easing.h"
+#include "../Graphics/Animate/Tween.h"
+#include "../Graphics/Animate/TweenEngine.h"
+#include "../Graphics/Animate/TweenSet.h"
+#include "../Graphics/Component/Image.h"
+#include "../Graphics/Page.h"
+#include "../Graphics/PageBuilder.h"
+#include "../Graphics/ViewInfo.h"
+#include "../Utility/Utils.h"
+#include <rapidxml.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr float frameTime = 1.0f / 60.0f;
+    constexpr int easingEvals = 1 << 20;
+
+    // As the layouts name them
+    const char* easingNames[] = {
+        "linear",
+        "easeInQuadratic", "easeOutQuadratic", "easeInOutQuadratic",
+        "easeInCubic", "easeOutCubic", "easeInOutCubic",
+        "easeInQuartic", "easeOutQuartic", "easeInOutQuartic",
+        "easeInQuintic", "easeOutQuintic", "easeInOutQuintic",
+        "easeInSine", "easeOutSine", "easeInOutSine",
+        "easeInExponential", "easeOutExponential", "easeInOutExponential",
+        "easeInCircular", "easeOutCircular", "easeInOutCircular"
+    };
+    constexpr int easingCount = EASE_INOUT_CIRCULAR + 1;
+
+    volatile float sink;
+
+    double microseconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void printFrames(const char* stage, const char* extra, const std::vector<double>& us, size_t components)
+    {
+        double mean = 0;
+        for (double sample : us) {
+            mean += sample;
+        }
+        mean /= us.empty() ? 1.0 : static_cast<double>(us.size());
+        printf("{\"stage\":\"%s\"%s,\"components\":%zu,\"frames\":%zu,\"us_mean\":%.3f,\"us_p50\":%.3f,\"us_p95\":%.3f,"
+            "\"ns_per_component\":%.1f}\n",
+            stage, extra, components, us.size(), mean, percentile(us, 0.5), percentile(us, 0.95),
+            components ? 1000.0 * mean / static_cast<double>(components) : 0.0);
+        fflush(stdout);
+    }
+
+    void benchmarkEasings()
+    {
+        for (bool tables : { false, true }) {
+            Easing::setTables(tables);
+            for (int type = 0; type < easingCount; ++type) {
+                auto algorithm = static_cast<TweenAlgorithm>(type);
+                float sum = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < easingEvals; ++i) {
+                    double elapsed = static_cast<double>(i & 1023) / 1023.0;
+                    sum += Tween::animateSingle(algorithm, 0, 100, 1, elapsed);
+                }
+                double us = microseconds(start);
+                sink = sum;
+                printf("{\"stage\":\"easing\",\"type\":\"%s\",\"tables\":%s,\"table\":%s,\"ns_per_eval\":%.3f}\n",
+                    easingNames[type], tables ? "true" : "false", Easing::table(algorithm) ? "true" : "false",
+                    1000.0 * us / easingEvals);
+            }
+        }
+        fflush(stdout);
+    }
+
+    std::shared_ptr<TweenSet> syntheticSet(double duration, double offset)
+    {
+        auto set = std::make_shared<TweenSet>();
+        set->push(std::make_unique<Tween>(TWEEN_PROPERTY_X, EASE_OUT_QUADRATIC, offset, 1000 + offset, duration));
+        set->push(std::make_unique<Tween>(TWEEN_PROPERTY_Y, EASE_INOUT_CUBIC, offset, 500 + offset, duration));
+        set->push(std::make_unique<Tween>(TWEEN_PROPERTY_ALPHA, LINEAR, 0, 1, duration));
+        set->push(std::make_unique<Tween>(TWEEN_PROPERTY_ANGLE, EASE_IN_SINE, 0, 360, duration));
+        return set;
+    }
+
+    // A four property set and a three set timeline on every component, ticked
+    // at staggered times so the clocks do not move in lockstep
+    void benchmarkEngine(size_t components, int frames)
+    {
+        std::shared_ptr<TweenSet> set = syntheticSet(1.0, 0);
+        Animation animation;
+        for (int i = 0; i < 3; ++i) {
+            animation.Push(syntheticSet(0.5, i * 100.0));
+        }
+
+        for (bool tables : { false, true }) {
+            Easing::setTables(tables);
+            for (bool timeline : { false, true }) {
+                TweenEngine engine;
+                std::vector<ViewInfo> views(components);
+                std::vector<TweenEngine::Clock*> clocks;
+                for (ViewInfo& view : views) {
+                    clocks.push_back(timeline ? engine.bind(animation.timeline(0), view, view)
+                                              : engine.bind(*set, view, view, 0));
+                }
+
+                std::vector<double> us;
+                for (int frame = 0; frame < frames; ++frame) {
+                    auto start = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < clocks.size(); ++i) {
+                        float elapsed = std::fmod(static_cast<float>(frame) * frameTime + static_cast<float>(i % 60) * frameTime,
+                            clocks[i]->duration);
+                        TweenEngine::tick(clocks[i], elapsed);
+                    }
+                    engine.update();
+                    us.push_back(microseconds(start));
+                }
+                std::string extra = std::string(",\"sets\":\"") + (timeline ? "timeline" : "single") +
+                    "\",\"tables\":" + (tables ? "true" : "false");
+                printFrames("engine", extra.c_str(), us, components);
+            }
+        }
+    }
+
+    // The animations of the components in the layout file, as the page builder
+    // reads them
+    std::vector<std::shared_ptr<AnimationEvents>> layoutAnimations(BenchmarkPage& loaded, std::vector<char>& buffer)
+    {
+        std::vector<std::shared_ptr<AnimationEvents>> animations;
+        std::string path = Utils::combinePath(Configuration::absolutePath, "layouts", loaded.layoutName, "layout.xml");
+        std::ifstream file(path.c_str());
+        if (!file.is_open()) {
+            fprintf(stderr, "Could not open %s\n", path.c_str());
+            return animations;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        buffer.push_back('\0');
+
+        rapidxml::xml_document<> doc;
+        try {
+            doc.parse<0>(buffer.data());
+        }
+        catch (const rapidxml::parse_error& e) {
+            fprintf(stderr, "Could not parse %s: %s\n", path.c_str(), e.what());
+            return animations;
+        }
+        rapidxml::xml_node<>* root = doc.first_node("layout");
+        for (auto* node = root ? root->first_node() : nullptr; node; node = node->next_sibling()) {
+            std::shared_ptr<AnimationEvents> events = loaded.builder->createTweenInstance(node);
+            for (int event = 0; event < ANIMATION_EVENT_COUNT; ++event) {
+                if (events->getAnimation(static_cast<AnimationEvent>(event))->size() > 0) {
+                    animations.push_back(events);
+                    break;
+                }
+            }
+        }
+        return animations;
+    }
+
+    // A quarter of the components enter again every second, the rest play
+    // their idle animations
+    void retrigger(const std::vector<Component*>& components, int frame)
+    {
+        if (frame % 60 != 0) {
+            return;
+        }
+        for (size_t i = static_cast<size_t>(frame / 60) % 4; i < components.size(); i += 4) {
+            components[i]->triggerEvent(ANIMATION_EVENT_ENTER);
+        }
+    }
+
+    void benchmarkPage(BenchmarkPage& loaded, size_t count, int frames)
+    {
+        Page* page = loaded.page;
+        std::vector<char> buffer;
+        std::vector<std::shared_ptr<AnimationEvents>> animations = layoutAnimations(loaded, buffer);
+        if (animations.empty()) {
+            fprintf(stderr, "No animated components in layout \"%s\"\n", loaded.layoutName.c_str());
+            return;
+        }
+
+        std::vector<Component*> components;
+        for (size_t i = 0; i < count; ++i) {
+            auto* image = new Image("", "", *page, 0, false, false);
+            image->setTweens(animations[i % animations.size()]);
+            image->triggerEvent(ANIMATION_EVENT_ENTER);
+            components.push_back(image);
+        }
+        std::string extra = ",\"layout\":\"" + loaded.layoutName + "\",\"animations\":" + std::to_string(animations.size()) +
+            ",\"tables\":" + (Easing::table(EASE_OUT_QUADRATIC) ? "true" : "false");
+
+        // The components alone, as Page::update runs them without threading
+        std::vector<double> us;
+        for (int frame = 0; frame < frames; ++frame) {
+            retrigger(components, frame);
+            auto start = std::chrono::steady_clock::now();
+            for (Component* component : components) {
+                component->update(frameTime);
+            }
+            page->getTweenEngine().update();
+            us.push_back(microseconds(start));
+        }
+        printFrames("componentUpdate", extra.c_str(), us, components.size());
+
+        // From here the page owns them and updates them with its own components
+        for (Component* component : components) {
+            page->addComponent(component);
+        }
+        for (bool threading : { false, true }) {
+            page->setThreading(threading);
+            std::string threadExtra = extra + ",\"threading\":" + (threading ? "true" : "false");
+
+            us.clear();
+            for (int frame = 0; frame < frames; ++frame) {
+                retrigger(components, frame);
+                auto start = std::chrono::steady_clock::now();
+                page->update(frameTime);
+                us.push_back(microseconds(start));
+            }
+            printFrames("pageUpdate", threadExtra.c_str(), us, components.size());
+
+            // A held scroll, every frame moves the menus a step and resets
+            // the tweens of their items
+            std::vector<double> scrollUs;
+            us.clear();
+            page->setScrolling(Page::ScrollDirectionForward);
+            for (int frame = 0; frame < frames; ++frame) {
+                auto start = std::chrono::steady_clock::now();
+                page->scroll(true, false);
+                page->updateScrollPeriod();
+                scrollUs.push_back(microseconds(start));
+                start = std::chrono::steady_clock::now();
+                page->update(frameTime);
+                us.push_back(microseconds(start));
+            }
+            page->setScrolling(Page::ScrollDirectionIdle);
+            page->resetScrollPeriod();
+            printFrames("scroll", threadExtra.c_str(), scrollUs, 0);
+            printFrames("scrollUpdate", threadExtra.c_str(), us, components.size());
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string dir;
+    std::string collectionName;
+    std::string layoutName;
+    size_t components = 500;
+    int frames = 600;
+    bool valid = true;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string param = argv[i];
+        std::string value = argv[i + 1];
+        if (param == "-dir") {
+            dir = value;
+        }
+        else if (param == "-collection") {
+            collectionName = value;
+        }
+        else if (param == "-layout") {
+            layoutName = value;
+        }
+        else if (param == "-components") {
+            components = static_cast<size_t>(std::max(1, std::atoi(value.c_str())));
+        }
+        else if (param == "-frames") {
+            frames = std::max(1, std::atoi(value.c_str()));
+        }
+        else {
+            valid = false;
+            break;
+        }
+    }
+    if (!valid || argc % 2 == 0 || dir.empty() != collectionName.empty()) {
+        fprintf(stderr, "Usage: %s [-components N] [-frames N] [-dir path -collection name [-layout name]]\n", argv[0]);
+        return 1;
+    }
+
+    benchmarkEasings();
+    benchmarkEngine(components, frames);
+
+    if (!dir.empty()) {
+        BenchmarkPage loaded;
+        if (!loaded.load(dir, collectionName, layoutName, 1920, 1080, false)) {
+            return 1;
+        }
+        benchmarkPage(loaded, components, frames);
+    }
+
+    return 0;
+}
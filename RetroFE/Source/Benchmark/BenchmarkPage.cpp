@@ -0,0 +1,169 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkPage.h"
+#include "../Collection/CollectionInfo.h"
+#include "../Collection/CollectionInfoBuilder.h"
+#include "../Collection/MenuParser.h"
+#include "../Database/DB.h"
+#include "../Database/GlobalOpts.h"
+#include "../Database/MetadataDatabase.h"
+#include "../Graphics/Animate/Easing.h"
+#include "../Graphics/FontCache.h"
+#include "../Graphics/Page.h"
+#include "../Graphics/PageBuilder.h"
+#include "../SDL.h"
+#include "../Utility/Utils.h"
+#include "../Video/VideoFactory.h"
+#include <gst/gst.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Same steps as RetroFE::getCollection, without subcollections and info files
+    CollectionInfo* buildCollection(Configuration& config, MetadataDatabase& metadb, const std::string& name)
+    {
+        CollectionInfoBuilder cib(config, metadb);
+        CollectionInfo* collection = cib.buildCollection(name);
+        if (!collection) {
+            return nullptr;
+        }
+        cib.injectMetadata(collection);
+
+        bool menuSort = true;
+        config.getProperty("collections." + name + ".list.menuSort", menuSort);
+        if (menuSort) {
+            config.getProperty("collections." + name + ".list.sortType", collection->sortType);
+            if (!Item::validSortType(collection->sortType)) {
+                collection->sortType = "";
+            }
+            collection->sortItems();
+        }
+
+        MenuParser mp;
+        mp.buildMenuItems(collection, menuSort);
+        cib.addPlaylists(collection);
+        collection->sortPlaylists();
+        return collection;
+    }
+
+    void importConfiguration(Configuration& config, const std::string& collection)
+    {
+        config.import("", Utils::combinePath(Configuration::absolutePath, "settings.conf"));
+        std::string collectionPath = Utils::combinePath(Configuration::absolutePath, "collections", collection);
+        for (const char* file : { "settings.conf", "info.conf" }) {
+            std::string path = Utils::combinePath(collectionPath, file);
+            if (fs::exists(path)) {
+                config.import(collection, "collections." + collection, path, false);
+            }
+        }
+    }
+}
+
+BenchmarkPage::BenchmarkPage() = default;
+
+BenchmarkPage::~BenchmarkPage()
+{
+    if (page) {
+        page->stop();
+        page->deInitialize();
+        delete page;
+    }
+    if (db_) {
+        db_->deInitialize();
+    }
+    if (sdl_) {
+        SDL::deInitialize();
+    }
+}
+
+bool BenchmarkPage::load(const std::string& dir, const std::string& collectionName, const std::string& layout,
+    int width, int height, bool video)
+{
+    // Nothing is shown and nothing is heard, the software renderer draws into
+    // the offscreen driver's framebuffer
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+
+    Configuration::absolutePath = fs::absolute(dir).string();
+    importConfiguration(config, collectionName);
+    config.setProperty(OPTION_NUMSCREENS, 1);
+    config.setProperty(OPTION_FULLSCREEN, false);
+    config.setProperty(OPTION_HORIZONTAL, width);
+    config.setProperty(OPTION_VERTICAL, height);
+    config.setProperty(OPTION_VSYNC, false);
+    config.setProperty(OPTION_PARALLELRENDER, false);
+    layoutName = layout;
+    if (!layoutName.empty()) {
+        config.setProperty(OPTION_LAYOUT, layoutName);
+    }
+    else if (!config.getProperty("collections." + collectionName + ".layout", layoutName) || layoutName.empty()) {
+        config.getProperty(OPTION_LAYOUT, layoutName);
+    }
+
+    gst_init(nullptr, nullptr);
+    VideoFactory::setEnabled(video);
+    bool easingTables = false;
+    config.getProperty(OPTION_EASINGTABLES, easingTables);
+    Easing::setTables(easingTables);
+
+    if (!SDL::initialize(config)) {
+        fprintf(stderr, "Could not initialize SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    sdl_ = true;
+    fontcache_ = std::make_unique<FontCache>();
+    fontcache_->initialize();
+
+    db_ = std::make_unique<DB>(Utils::combinePath(Configuration::absolutePath, "meta.db"));
+    if (!db_->initialize()) {
+        fprintf(stderr, "Could not open database\n");
+        return false;
+    }
+    metadb_ = std::make_unique<MetadataDatabase>(*db_, config);
+    metadb_->initialize();
+
+    auto start = std::chrono::steady_clock::now();
+    builder = std::make_unique<PageBuilder>(layoutName, "layout", config, fontcache_.get());
+    page = builder->buildPage(collectionName);
+    collection = page ? buildCollection(config, *metadb_, collectionName) : nullptr;
+    if (!page || !collection || !page->pushCollection(collection)) {
+        fprintf(stderr, "Could not load layout \"%s\" with collection \"%s\"\n", layoutName.c_str(), collectionName.c_str());
+        return false;
+    }
+    page->selectPlaylist("all");
+    page->onNewItemSelected();
+    page->reallocateMenuSpritePoints();
+    page->start();
+    buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+double percentile(std::vector<double> values, double p)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+    return values[index];
+}
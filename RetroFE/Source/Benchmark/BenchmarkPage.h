@@ -0,0 +1,55 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "../Database/Configuration.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class CollectionInfo;
+class DB;
+class FontCache;
+class MetadataDatabase;
+class Page;
+class PageBuilder;
+
+// Loads a layout page with a collection from a RetroFE install onto SDL's
+// software renderer, without a window or a GPU, as the benchmarks use it.
+class BenchmarkPage
+{
+public:
+    BenchmarkPage();
+    ~BenchmarkPage();
+    // The layout is the collection's when empty. Errors are printed.
+    bool load(const std::string& dir, const std::string& collectionName, const std::string& layoutName,
+        int width, int height, bool video);
+
+    Configuration config;
+    std::string layoutName;
+    Page* page{ nullptr };
+    CollectionInfo* collection{ nullptr };
+    double buildSeconds{ 0 }; // building the page and the collection
+    std::unique_ptr<PageBuilder> builder; // kept to build more from the layout
+
+private:
+    std::unique_ptr<FontCache> fontcache_;
+    std::unique_ptr<DB> db_;
+    std::unique_ptr<MetadataDatabase> metadb_;
+    bool sdl_{ false };
+};
+
+double percentile(std::vector<double> values, double p);
@@ -0,0 +1,82 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks the sampled easing tables against the analytic curves.
+//
+// Usage: easing_check
+//
+// Fails when a table is off by more than Easing::tableTolerance anywhere, or
+// when a curve that should be sampled falls back to the analytic one. Prints
+// one JSON object per easing.
+
+#include "../Graphics/Animate/Easing.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    const char* easingNames[] = {
+        "linear",
+        "easeInQuadratic", "easeOutQuadratic", "easeInOutQuadratic",
+        "easeInCubic", "easeOutCubic", "easeInOutCubic",
+        "easeInQuartic", "easeOutQuartic", "easeInOutQuartic",
+        "easeInQuintic", "easeOutQuintic", "easeInOutQuintic",
+        "easeInSine", "easeOutSine", "easeInOutSine",
+        "easeInExponential", "easeOutExponential", "easeInOutExponential",
+        "easeInCircular", "easeOutCircular", "easeInOutCircular"
+    };
+    constexpr int easingCount = EASE_INOUT_CIRCULAR + 1;
+
+    // Finer than the check setTables() does itself
+    constexpr int checksPerInterval = 64;
+
+    // Linear needs no table, the circular curves turn vertical at an end
+    bool staysAnalytic(TweenAlgorithm type)
+    {
+        return type == LINEAR || type == EASE_IN_CIRCULAR || type == EASE_OUT_CIRCULAR || type == EASE_INOUT_CIRCULAR;
+    }
+}
+
+int main()
+{
+    Easing::setTables(true);
+
+    int failures = 0;
+    for (int type = 0; type < easingCount; ++type) {
+        auto algorithm = static_cast<TweenAlgorithm>(type);
+        const float* table = Easing::table(algorithm);
+
+        float error = 0;
+        if (table) {
+            constexpr int checks = Easing::tableIntervals * checksPerInterval;
+            for (int i = 0; i <= checks; ++i) {
+                float p = static_cast<float>(i) / checks;
+                error = std::max(error, std::abs(Easing::lookup(table, p) - Easing::analytic(algorithm, p)));
+            }
+        }
+
+        bool ok = table ? error <= Easing::tableTolerance : staysAnalytic(algorithm);
+        if (!ok) {
+            ++failures;
+        }
+        printf("{\"easing\":\"%s\",\"table\":%s,\"max_error\":%.3e,\"ok\":%s}\n",
+            easingNames[type], table ? "true" : "false", error, ok ? "true" : "false");
+    }
+
+    printf("{\"summary\":\"easing_check\",\"tolerance\":%.3e,\"failures\":%d}\n", Easing::tableTolerance, failures);
+    return failures == 0 ? 0 : 1;
+}
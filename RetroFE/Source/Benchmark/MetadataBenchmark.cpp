@@ -0,0 +1,246 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Times the metadata import and lookup path against synthetic lists.
+//
+// Usage: metadata_benchmark [-entries N] [-dir path]
+//
+// Every stage prints one JSON object per line so results can be collected by
+// scripts and compared between builds.
+
+#include "../Collection/CollectionInfo.h"
+#include "../Collection/Item.h"
+#include "../Database/Configuration.h"
+#include "../Database/DB.h"
+#include "../Database/GlobalOpts.h"
+#include "../Database/MetadataDatabase.h"
+#include "../Database/MetadataSnapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const char* genres[] = { "Shooter", "Platform", "Fighter", "Maze", "Sports", "Racing", "Puzzle" };
+    const char* manufacturers[] = { "Capcom", "Namco", "Nintendo", "SNK", "Konami", "Sega", "Taito" };
+    const char* words[] = { "Super", "Street", "Final", "Metal", "Star", "Dragon", "Galaxy", "Ninja", "Turbo", "Space" };
+
+    size_t peakRssKb()
+    {
+#ifdef WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.PeakWorkingSetSize / 1024;
+        }
+        return 0;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+        return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+    }
+
+    std::string gameName(size_t i)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "game%06zu", i);
+        return buffer;
+    }
+
+    std::string gameTitle(size_t i)
+    {
+        return std::string(words[i % 10]) + " " + words[(i / 10) % 10] + " " + std::to_string(i);
+    }
+
+    void writeHyperlist(const fs::path& file, size_t entries)
+    {
+        std::ofstream out(file);
+        out << "<menu>\n";
+        for (size_t i = 0; i < entries; ++i) {
+            out << "<game name=\"" << gameName(i) << "\">"
+                << "<description>" << gameTitle(i) << "</description>"
+                << "<cloneof></cloneof>"
+                << "<year>" << 1978 + i % 30 << "</year>"
+                << "<manufacturer>" << manufacturers[i % 7] << "</manufacturer>"
+                << "<genre>" << genres[i % 7] << "</genre>"
+                << "<players>" << 1 + i % 4 << "</players>"
+                << "<rating>" << "Other - NR (Not Rated)" << "</rating>"
+                << "</game>\n";
+        }
+        out << "</menu>\n";
+    }
+
+    void writeMamelist(const fs::path& file, size_t entries)
+    {
+        std::ofstream out(file);
+        out << "<mame build=\"benchmark\">\n";
+        for (size_t i = 0; i < entries; ++i) {
+            out << "<machine name=\"" << gameName(i) << "\"" << (i % 5 == 0 && i > 0 ? " cloneof=\"" + gameName(i - 1) + "\"" : "") << ">"
+                << "<description>" << gameTitle(i) << "</description>"
+                << "<year>" << 1978 + i % 30 << "</year>"
+                << "<manufacturer>" << manufacturers[i % 7] << "</manufacturer>"
+                << "<input players=\"" << 1 + i % 4 << "\" buttons=\"" << i % 7 << "\"/>"
+                << "</machine>\n";
+        }
+        out << "</mame>\n";
+    }
+
+    CollectionInfo* buildCollection(Configuration& config, const std::string& metadataType, size_t entries)
+    {
+        auto* collection = new CollectionInfo(config, metadataType, "", "", metadataType, "");
+        for (size_t i = 0; i < entries; ++i) {
+            auto* item = new Item();
+            item->name = gameName(i);
+            item->title = item->name;
+            item->fullTitle = item->name;
+            item->collectionInfo = collection;
+            collection->items.push_back(item);
+        }
+        std::shuffle(collection->items.begin(), collection->items.end(), std::mt19937(1));
+        return collection;
+    }
+
+    void report(const char* stage, size_t entries, const std::function<bool()>& fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("{\"stage\":\"%s\",\"entries\":%zu,\"ok\":%s,\"seconds\":%.6f,\"entries_per_second\":%.0f,\"peak_rss_kb\":%zu}\n",
+            stage, entries, ok ? "true" : "false", seconds, seconds > 0 ? entries / seconds : 0.0, peakRssKb());
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t entries = 10000;
+    fs::path dir = fs::temp_directory_path() / "retrofe_metadata_benchmark";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string param = argv[i];
+        if (param == "-entries") {
+            entries = static_cast<size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+        }
+        else if (param == "-dir") {
+            dir = argv[i + 1];
+        }
+        else {
+            fprintf(stderr, "Usage: %s [-entries N] [-dir path]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir / "lists", ec);
+    if (ec) {
+        fprintf(stderr, "Could not create %s: %s\n", dir.string().c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    // Lists live outside meta/ so initialize() only creates the schema
+    fs::path hyperlist = dir / "lists" / "Bench.xml";
+    fs::path mamelist = dir / "lists" / "BenchMame.xml";
+    report("generateXml", entries * 2, [&]() {
+        writeHyperlist(hyperlist, entries);
+        writeMamelist(mamelist, entries);
+        return true;
+    });
+
+    Configuration::absolutePath = dir.string();
+    Configuration config;
+    config.setProperty(OPTION_METALOCK, false);
+
+    DB db((dir / "meta.db").string());
+    if (!db.initialize()) {
+        fprintf(stderr, "Could not open database\n");
+        return 1;
+    }
+    MetadataDatabase metadb(db, config);
+    metadb.initialize();
+
+    report("importHyperlist", entries, [&]() { return metadb.importHyperlist(hyperlist.string(), "Bench"); });
+    report("importMamelist", entries, [&]() { return metadb.importMamelist(mamelist.string(), "BenchMame"); });
+
+    CollectionInfo* hyperCollection = buildCollection(config, "Bench", entries);
+    CollectionInfo* mameCollection = buildCollection(config, "BenchMame", entries);
+
+    report("injectMetadata", entries, [&]() {
+        metadb.injectMetadata(hyperCollection);
+        return hyperCollection->items.front()->title != hyperCollection->items.front()->name;
+    });
+    report("injectMetadataMame", entries, [&]() {
+        metadb.injectMetadata(mameCollection);
+        return mameCollection->items.front()->title != mameCollection->items.front()->name;
+    });
+    report("sortItems", entries, [&]() {
+        hyperCollection->sortItems();
+        return true;
+    });
+    // The first search builds the index, which sortItems() dropped, so only
+    // the queries after it are timed. Entries counts the queries here.
+    const char* queries[] = { "genre:shoot super", "street", "dra", "capcom 1985", "year:199 ninja" };
+    constexpr size_t searchRounds = 200;
+    hyperCollection->search(queries[0]);
+    report("search", searchRounds * std::size(queries), [&]() {
+        bool found = false;
+        for (size_t round = 0; round < searchRounds; ++round) {
+            for (const char* query : queries) {
+                found |= hyperCollection->search(query);
+            }
+        }
+        return found;
+    });
+
+    report("exportSnapshot", entries * 2, [&]() { return metadb.exportSnapshot(); });
+    MetadataSnapshot snapshot;
+    report("openSnapshot", entries * 2, [&]() { return snapshot.open((dir / "meta.snapshot").string()); });
+    CollectionInfo* snapshotCollection = buildCollection(config, "Bench", entries);
+    report("injectSnapshot", entries, [&]() {
+        snapshot.injectMetadata(snapshotCollection);
+        return snapshotCollection->items.front()->title != snapshotCollection->items.front()->name;
+    });
+    snapshot.close();
+
+    delete snapshotCollection;
+    delete hyperCollection;
+    delete mameCollection;
+    db.deInitialize();
+    fs::remove_all(dir, ec);
+
+    return 0;
+}
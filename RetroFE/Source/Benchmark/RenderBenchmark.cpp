@@ -0,0 +1,203 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Times the update and draw of a layout page on SDL's software renderer,
+// without a window or a GPU.
+//
+// Usage: render_benchmark -dir path -collection name [-layout name]
+//                         [-frames N] [-width W] [-height H] [-video true|false]
+//
+// The directory is a RetroFE install with settings.conf and the collection.
+// The page is idle, scrolls forward, scrolls back, changes playlists and
+// settles again, each for a fifth of the frames. Every frame prints one JSON
+// object per line, followed by a summary per phase with the texture memory.
+
+#include "BenchmarkPage.h"
+#include "../Collection/CollectionInfo.h"
+#include "../Graphics/Page.h"
+#include "../Graphics/TextureRegistry.h"
+#include "../SDL.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* phases[] = { "idle", "scrollForward", "scrollBack", "playlist", "settle" };
+    constexpr int phaseCount = 5;
+    constexpr float frameTime = 1.0f / 60.0f;
+
+    struct FrameSample
+    {
+        double wallMs;
+        double cpuMs;
+        SDL::FrameStats stats;
+    };
+
+    void summarize(const char* phase, const std::vector<FrameSample>& samples)
+    {
+        std::vector<double> wall;
+        double cpu = 0;
+        uint64_t copies = 0;
+        uint64_t drawCalls = 0;
+        uint64_t presents = 0;
+        uint64_t uploadBytes = 0;
+        for (const FrameSample& sample : samples) {
+            wall.push_back(sample.wallMs);
+            cpu += sample.cpuMs;
+            copies += sample.stats.copies;
+            drawCalls += sample.stats.drawCalls;
+            presents += sample.stats.presents;
+            uploadBytes += sample.stats.uploadBytes;
+        }
+        double frames = samples.empty() ? 1.0 : static_cast<double>(samples.size());
+        double mean = 0;
+        for (double ms : wall) {
+            mean += ms;
+        }
+        printf("{\"summary\":\"%s\",\"frames\":%zu,\"wall_ms_mean\":%.3f,\"wall_ms_p50\":%.3f,\"wall_ms_p95\":%.3f,"
+            "\"wall_ms_max\":%.3f,\"cpu_ms_mean\":%.3f,\"copies_mean\":%.1f,\"draw_calls_mean\":%.1f,"
+            "\"presents\":%llu,\"upload_bytes\":%llu,\"texture_bytes\":%llu}\n",
+            phase, samples.size(), mean / frames, percentile(wall, 0.5), percentile(wall, 0.95),
+            wall.empty() ? 0.0 : *std::max_element(wall.begin(), wall.end()), cpu / frames,
+            static_cast<double>(copies) / frames, static_cast<double>(drawCalls) / frames,
+            static_cast<unsigned long long>(presents), static_cast<unsigned long long>(uploadBytes),
+            static_cast<unsigned long long>(TextureRegistry::getBytes()));
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string dir;
+    std::string collectionName;
+    std::string layoutName;
+    int frames = 1500;
+    int width = 1920;
+    int height = 1080;
+    bool video = false;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string param = argv[i];
+        std::string value = argv[i + 1];
+        if (param == "-dir") {
+            dir = value;
+        }
+        else if (param == "-collection") {
+            collectionName = value;
+        }
+        else if (param == "-layout") {
+            layoutName = value;
+        }
+        else if (param == "-frames") {
+            frames = std::max(phaseCount, std::atoi(value.c_str()));
+        }
+        else if (param == "-width") {
+            width = std::atoi(value.c_str());
+        }
+        else if (param == "-height") {
+            height = std::atoi(value.c_str());
+        }
+        else if (param == "-video") {
+            video = value == "true";
+        }
+        else {
+            dir.clear();
+            break;
+        }
+    }
+    if (dir.empty() || collectionName.empty()) {
+        fprintf(stderr, "Usage: %s -dir path -collection name [-layout name] [-frames N] [-width W] [-height H] [-video true|false]\n", argv[0]);
+        return 1;
+    }
+
+    BenchmarkPage loaded;
+    if (!loaded.load(dir, collectionName, layoutName, width, height, video)) {
+        return 1;
+    }
+    Page* page = loaded.page;
+    printf("{\"stage\":\"buildPage\",\"layout\":\"%s\",\"collection\":\"%s\",\"items\":%zu,\"seconds\":%.6f}\n",
+        loaded.layoutName.c_str(), collectionName.c_str(), loaded.collection->items.size(), loaded.buildSeconds);
+    SDL::takeFrameStats();
+
+    std::vector<FrameSample> samples[phaseCount];
+    bool playlistExiting = false;
+    for (int frame = 0; frame < frames; ++frame) {
+        int phase = std::min(frame * phaseCount / frames, phaseCount - 1);
+
+        auto wallStart = std::chrono::steady_clock::now();
+        std::clock_t cpuStart = std::clock();
+
+        // The scripted input, paced by the page like the main loop does
+        if (page->isIdle()) {
+            if (phase == 1 || phase == 2) {
+                bool forward = phase == 1;
+                page->setScrolling(forward ? Page::ScrollDirectionForward : Page::ScrollDirectionBack);
+                page->scroll(forward, false);
+                page->updateScrollPeriod();
+            }
+            else if (phase == 3 && !playlistExiting) {
+                page->setScrolling(Page::ScrollDirectionIdle);
+                page->playlistExit();
+                playlistExiting = true;
+            }
+            else if (playlistExiting) {
+                page->nextPlaylist();
+                page->onNewItemSelected();
+                page->reallocateMenuSpritePoints();
+                page->playlistEnter();
+                playlistExiting = false;
+            }
+            else {
+                page->setScrolling(Page::ScrollDirectionIdle);
+            }
+        }
+
+        page->update(frameTime);
+
+        SDL_LockMutex(SDL::getMutex());
+        SDL::updateTransforms();
+        SDL::beginFrame();
+        page->draw();
+        SDL::endFrames();
+        SDL_UnlockMutex(SDL::getMutex());
+
+        FrameSample sample;
+        sample.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+        sample.cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        sample.stats = SDL::takeFrameStats();
+        samples[phase].push_back(sample);
+
+        printf("{\"frame\":%d,\"phase\":\"%s\",\"wall_ms\":%.3f,\"cpu_ms\":%.3f,\"copies\":%llu,\"draw_calls\":%llu,"
+            "\"presents\":%llu,\"upload_bytes\":%llu}\n",
+            frame, phases[phase], sample.wallMs, sample.cpuMs,
+            static_cast<unsigned long long>(sample.stats.copies), static_cast<unsigned long long>(sample.stats.drawCalls),
+            static_cast<unsigned long long>(sample.stats.presents), static_cast<unsigned long long>(sample.stats.uploadBytes));
+    }
+
+    std::vector<FrameSample> all;
+    for (int phase = 0; phase < phaseCount; ++phase) {
+        summarize(phases[phase], samples[phase]);
+        all.insert(all.end(), samples[phase].begin(), samples[phase].end());
+    }
+    summarize("all", all);
+
+    return 0;
+}
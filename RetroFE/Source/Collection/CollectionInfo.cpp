@@ -15,6 +15,7 @@
  */
 #include "CollectionInfo.h"
 #include "Item.h"
+#include "SearchIndex.h"
 #include "../Database/Configuration.h"
 #include "../Database/GlobalOpts.h"
 #include "../Utility/Utils.h"
@@ -284,6 +285,47 @@ auto CollectionInfo::itemIsLess(const std::string& sortTypeParam, bool currentCo
 void CollectionInfo::sortItems()
 {
     std::sort(items.begin(), items.end(), itemIsLess("", menusort));
+    invalidateSearchIndex();
+}
+
+// Fills the "search" playlist with the items matching query, an empty query
+// empties it. The index is built on first use and kept until the item list
+// changes.
+bool CollectionInfo::search(const std::string& query)
+{
+    auto it = playlists.find("search");
+    if (it == playlists.end()) {
+        it = playlists.try_emplace("search", new std::vector<Item*>()).first;
+    }
+
+    if (query.empty()) {
+        it->second->clear();
+        return false;
+    }
+
+    if (!searchIndex_ || searchIndex_->itemCount() != items.size()) {
+        searchIndex_ = std::make_unique<SearchIndex>();
+        searchIndex_->build(items);
+    }
+    *it->second = searchIndex_->query(query);
+
+    return !it->second->empty();
+}
+
+// Number of search results per distinct value of field (e.g. "genre")
+std::map<std::string, size_t, std::less<>> CollectionInfo::searchFacets(const std::string& field) const
+{
+    SearchIndex::Field f;
+    auto it = playlists.find("search");
+    if (!searchIndex_ || it == playlists.end() || !SearchIndex::fieldFromName(field, f)) {
+        return {};
+    }
+    return searchIndex_->facetCounts(f, *it->second);
+}
+
+void CollectionInfo::invalidateSearchIndex()
+{
+    searchIndex_.reset();
 }
 
 
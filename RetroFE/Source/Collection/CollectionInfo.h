@@ -18,9 +18,11 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 class Item;
 class Configuration;
+class SearchIndex;
 
 class CollectionInfo
 {
@@ -35,6 +37,9 @@ public:
     void addSubcollection(CollectionInfo *info);
     auto itemIsLess(const std::string& sortType, bool currentCollectionMenusort) const;
     void extensionList(std::vector<std::string> &extensions) const;
+    bool search(const std::string& query);
+    std::map<std::string, size_t, std::less<>> searchFacets(const std::string& field) const;
+    void invalidateSearchIndex();
     std::string name;
     std::string lowercaseName() const;
     std::string listpath;
@@ -55,4 +60,5 @@ private:
     Configuration& conf_;
     std::string metadataPath_;
     std::string extensions_;
+    std::unique_ptr<SearchIndex> searchIndex_;
 };
@@ -0,0 +1,231 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SearchIndex.h"
+#include "Item.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+    char foldChar(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool isWordChar(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+            static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    // Splits text into lower-cased words, calling fn for each one
+    template <typename Fn>
+    void forEachWord(std::string_view text, Fn&& fn)
+    {
+        std::string word;
+        for (char c : text) {
+            if (isWordChar(c)) {
+                word.push_back(foldChar(c));
+            }
+            else if (!word.empty()) {
+                fn(word);
+                word.clear();
+            }
+        }
+        if (!word.empty()) {
+            fn(word);
+        }
+    }
+}
+
+void SearchIndex::build(const std::vector<Item*>& items)
+{
+    clear();
+    items_ = items;
+
+    std::unordered_map<std::string, size_t> lookup;
+    for (uint32_t id = 0; id < items_.size(); ++id) {
+        const Item* item = items_[id];
+        for (int f = 0; f < FIELD_COUNT; ++f) {
+            auto field = static_cast<Field>(f);
+            forEachWord(fieldValue(item, field), [&](const std::string& word) {
+                std::string key = word;
+                key.push_back(static_cast<char>(field));
+                auto [it, inserted] = lookup.try_emplace(key, postings_.size());
+                if (inserted) {
+                    postings_.push_back({ word, field, {} });
+                }
+                std::vector<uint32_t>& ids = postings_[it->second].items;
+                if (ids.empty() || ids.back() != id) {
+                    ids.push_back(id);
+                }
+            });
+        }
+    }
+
+    std::sort(postings_.begin(), postings_.end(), [](const Posting& a, const Posting& b) {
+        if (a.token != b.token)
+            return a.token < b.token;
+        return a.field < b.field;
+    });
+}
+
+void SearchIndex::clear()
+{
+    items_.clear();
+    postings_.clear();
+}
+
+bool SearchIndex::empty() const
+{
+    return items_.empty();
+}
+
+size_t SearchIndex::itemCount() const
+{
+    return items_.size();
+}
+
+void SearchIndex::matchTerm(std::string_view term, int field, Bitmap& out) const
+{
+    auto it = std::lower_bound(postings_.begin(), postings_.end(), term, [](const Posting& p, std::string_view t) {
+        return p.token < t;
+    });
+
+    for (; it != postings_.end() && it->token.compare(0, term.size(), term) == 0; ++it) {
+        if (field >= 0 && it->field != field) {
+            continue;
+        }
+        for (uint32_t id : it->items) {
+            out[id >> 6] |= uint64_t(1) << (id & 63);
+        }
+    }
+}
+
+std::vector<Item*> SearchIndex::query(std::string_view query) const
+{
+    std::vector<Item*> results;
+    if (items_.empty()) {
+        return results;
+    }
+
+    size_t words = (items_.size() + 63) / 64;
+    Bitmap matches(words, ~uint64_t(0));
+    Bitmap term(words);
+    bool anyTerm = false;
+
+    size_t pos = 0;
+    while (pos < query.size()) {
+        size_t end = query.find(' ', pos);
+        if (end == std::string_view::npos) {
+            end = query.size();
+        }
+        std::string_view raw = query.substr(pos, end - pos);
+        pos = end + 1;
+
+        int field = -1;
+        if (size_t colon = raw.find(':'); colon != std::string_view::npos) {
+            Field f;
+            if (fieldFromName(raw.substr(0, colon), f)) {
+                field = f;
+                raw = raw.substr(colon + 1);
+            }
+        }
+
+        // A term such as "f-zero" is split into words that must all match
+        forEachWord(raw, [&](const std::string& word) {
+            std::fill(term.begin(), term.end(), 0);
+            matchTerm(word, field, term);
+            for (size_t i = 0; i < words; ++i) {
+                matches[i] &= term[i];
+            }
+            anyTerm = true;
+        });
+    }
+
+    if (!anyTerm) {
+        return results;
+    }
+
+    for (size_t i = 0; i < words; ++i) {
+        if (!matches[i]) {
+            continue;
+        }
+        for (size_t bit = 0; bit < 64; ++bit) {
+            size_t id = i * 64 + bit;
+            if (id < items_.size() && (matches[i] >> bit) & 1) {
+                results.push_back(items_[id]);
+            }
+        }
+    }
+
+    return results;
+}
+
+std::map<std::string, size_t, std::less<>> SearchIndex::facetCounts(Field field, const std::vector<Item*>& results) const
+{
+    std::map<std::string, size_t, std::less<>> counts;
+    for (const Item* item : results) {
+        const std::string& value = fieldValue(item, field);
+        if (!value.empty()) {
+            counts[value]++;
+        }
+    }
+    return counts;
+}
+
+bool SearchIndex::fieldFromName(std::string_view name, Field& field)
+{
+    static const std::pair<std::string_view, Field> names[] = {
+        { "name", FIELD_NAME },
+        { "title", FIELD_TITLE },
+        { "year", FIELD_YEAR },
+        { "manufacturer", FIELD_MANUFACTURER },
+        { "manu", FIELD_MANUFACTURER },
+        { "developer", FIELD_DEVELOPER },
+        { "dev", FIELD_DEVELOPER },
+        { "genre", FIELD_GENRE },
+        { "players", FIELD_PLAYERS },
+        { "ctrltype", FIELD_CTRLTYPE },
+        { "rating", FIELD_RATING },
+    };
+
+    for (const auto& [n, f] : names) {
+        if (n.size() == name.size() &&
+            std::equal(n.begin(), n.end(), name.begin(), [](char a, char b) { return a == foldChar(b); })) {
+            field = f;
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string& SearchIndex::fieldValue(const Item* item, Field field)
+{
+    static const std::string empty;
+    switch (field) {
+        case FIELD_NAME:         return item->name;
+        case FIELD_TITLE:        return item->fullTitle.empty() ? item->title : item->fullTitle;
+        case FIELD_YEAR:         return item->year;
+        case FIELD_MANUFACTURER: return item->manufacturer;
+        case FIELD_DEVELOPER:    return item->developer;
+        case FIELD_GENRE:        return item->genre;
+        case FIELD_PLAYERS:      return item->numberPlayers;
+        case FIELD_CTRLTYPE:     return item->ctrlType;
+        case FIELD_RATING:       return item->rating;
+        default:                 return empty;
+    }
+}
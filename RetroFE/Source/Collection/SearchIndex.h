@@ -0,0 +1,76 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Item;
+
+// In-memory inverted index over the metadata fields of a set of items.
+//
+// A query is a whitespace separated list of terms which must all match. Every
+// term is a prefix match against the words of an item, "field:term" limits
+// the term to a single field (e.g. "genre:shoot manu:capcom").
+class SearchIndex
+{
+public:
+    enum Field : uint8_t
+    {
+        FIELD_NAME,
+        FIELD_TITLE,
+        FIELD_YEAR,
+        FIELD_MANUFACTURER,
+        FIELD_DEVELOPER,
+        FIELD_GENRE,
+        FIELD_PLAYERS,
+        FIELD_CTRLTYPE,
+        FIELD_RATING,
+        FIELD_COUNT
+    };
+
+    void build(const std::vector<Item*>& items);
+    void clear();
+    bool empty() const;
+    size_t itemCount() const;
+
+    // Matching items in the order they were indexed
+    std::vector<Item*> query(std::string_view query) const;
+
+    // Number of matching items per distinct value of field
+    std::map<std::string, size_t, std::less<>> facetCounts(Field field, const std::vector<Item*>& results) const;
+
+    static bool fieldFromName(std::string_view name, Field& field);
+    static const std::string& fieldValue(const Item* item, Field field);
+
+private:
+    struct Posting
+    {
+        std::string token;
+        Field field;
+        std::vector<uint32_t> items;
+    };
+
+    using Bitmap = std::vector<uint64_t>;
+
+    void matchTerm(std::string_view term, int field, Bitmap& out) const;
+
+    std::vector<Item*> items_;
+    std::vector<Posting> postings_; // sorted by token, then field
+};
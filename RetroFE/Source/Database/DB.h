@@ -25,6 +25,7 @@ public:
     void deInitialize();
     virtual ~DB();
     sqlite3 *handle;
+    const std::string& path() const { return path_; }
 
 private:
     std::string path_;
@@ -49,7 +49,7 @@ const global_options::options_entry global_options::s_option_entries[] =
     { OPTION_WINDOWBORDER,            "false",     global_options::option_type::BOOLEAN,  "Show window border" },
     { OPTION_WINDOWRESIZE,            "false",     global_options::option_type::BOOLEAN,  "Allow window to be resized" },
     { OPTION_FPS,                     "60",        global_options::option_type::INTEGER,  "Requested FPS while in an active state" },
-    { OPTION_FPSIDLE,                 "60",        global_options::option_type::INTEGER,  "Request FPS while in an idle state" },
+    { OPTION_FPSIDLE,                 "60",        global_options::option_type::INTEGER,  "Request FPS once nothing has moved on screen for half a second" },
     { OPTION_HIDEMOUSE,               "true",      global_options::option_type::BOOLEAN,  "Defines whether the mouse cursor is hidden" },
     { OPTION_ANIMATEDURINGGAME,       "true",      global_options::option_type::BOOLEAN,  "Pause animated marquees while in the game" },
 
@@ -71,6 +71,13 @@ const global_options::options_entry global_options::s_option_entries[] =
     { OPTION_MINIMIZEONFOCUSLOSS,      "false",    global_options::option_type::BOOLEAN,  "Minimize RetroFE when focus is lost" },
     { OPTION_AVDECTHREADTYPE,          "2",        global_options::option_type::INTEGER,  "Type of threading in the case of software decoding (1=frame, 2=slice)" },
     { OPTION_GLSWAPINTERVAL,           "1",        global_options::option_type::INTEGER,  "OpenGL Swap Interval (0=immediate updates, 1=synchronized vsync, -1=adaptive vsync" },
+    { OPTION_RENDERBATCHING,           "true",     global_options::option_type::BOOLEAN,  "Submit consecutive draws of the same texture together instead of one call per image or glyph" },
+    { OPTION_SKIPIDLEFRAMES,           "true",     global_options::option_type::BOOLEAN,  "Skip drawing and presenting frames where nothing on screen changed" },
+    { OPTION_DIRECTRENDER,             "false",    global_options::option_type::BOOLEAN,  "Draw screens without rotation or mirroring straight to the window instead of through an intermediate texture" },
+    { OPTION_PARALLELRENDER,           "false",    global_options::option_type::BOOLEAN,  "Draw and present every screen from its own thread so multiple monitors wait on vSync together. Not used with OpenGL" },
+    { OPTION_LAYERCACHE,               "true",     global_options::option_type::BOOLEAN,  "Composite runs of layers that stopped changing into a cached texture drawn with a single copy" },
+    { OPTION_TEXTUREBUDGET,            "0",        global_options::option_type::INTEGER,  "Megabytes of texture memory to stay under by dropping cached artwork that is not on screen, 0 for no limit" },
+    { OPTION_EASINGTABLES,             "false",    global_options::option_type::BOOLEAN,  "Evaluate tween easings from curves sampled at startup instead of computing them every frame" },
 
     { nullptr,                         nullptr,    global_options::option_type::HEADER,   "CUSTOMIZATION OPTIONS" },
     { OPTION_LAYOUT,                   "Arcades",  global_options::option_type::STRING,   "Theme to be used in RetroFE, a folder name in /layouts" },
@@ -128,8 +135,9 @@ const global_options::options_entry global_options::s_option_entries[] =
     { OPTION_SERVOSTIKENABLED,         "false",    global_options::option_type::BOOLEAN,   "Enable ServoStik support" },
 
     { nullptr,                         nullptr,    global_options::option_type::HEADER,   "METADATA OPTIONS" },
-    { OPTION_METALOCK,                 "true",     global_options::option_type::BOOLEAN,  "Locks RetroFE from looking for XML changes and uses meta.db, faster loading when true" },
+    { OPTION_METALOCK,                 "true",     global_options::option_type::BOOLEAN,  "Locks RetroFE from looking for XML changes and uses meta.db (or meta.snapshot if exported), faster loading when true" },
     { OPTION_OVERWRITEXML,             "false",    global_options::option_type::BOOLEAN,  "Allows metadata XMLs to be overwritten by files in a collection" },
+    { OPTION_BACKGROUNDMETAIMPORT,     "true",     global_options::option_type::BOOLEAN,  "Import changed metadata XMLs after the frontend has started instead of during the splash screen" },
     { OPTION_SHOWPARENTHESIS,          "true",     global_options::option_type::BOOLEAN,  "Show item information between ()" },
     { OPTION_SHOWSQUAREBRACKETS,       "true",     global_options::option_type::BOOLEAN,  "Show item information between []" },
 
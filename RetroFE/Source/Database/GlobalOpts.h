@@ -65,6 +65,13 @@
 #define OPTION_MINIMIZEONFOCUSLOSS   "minimizeOnFocusLoss"
 #define OPTION_AVDECTHREADTYPE       "AvdecThreadType"
 #define OPTION_GLSWAPINTERVAL        "GlSwapInterval"
+#define OPTION_RENDERBATCHING        "renderBatching"
+#define OPTION_SKIPIDLEFRAMES        "skipIdleFrames"
+#define OPTION_DIRECTRENDER          "directRender"
+#define OPTION_PARALLELRENDER        "parallelRender"
+#define OPTION_LAYERCACHE            "layerCache"
+#define OPTION_TEXTUREBUDGET         "textureBudget"
+#define OPTION_EASINGTABLES          "easingTables"
 
 // CUSTOMIZATION OPTIONS
 #define OPTION_LAYOUT                "layout"
@@ -123,6 +130,7 @@
 // METADATA OPTIONS
 #define OPTION_METALOCK               "metaLock"
 #define OPTION_OVERWRITEXML           "overwriteXML"
+#define OPTION_BACKGROUNDMETAIMPORT   "backgroundMetaImport"
 #define OPTION_SHOWPARENTHESIS        "showParenthesis"
 #define OPTION_SHOWSQUAREBRACKETS     "showSquareBrackets"
 
@@ -198,6 +206,13 @@ public:
     bool minimizeonfocusloss() { return bool_value(OPTION_MINIMIZEONFOCUSLOSS); }
     int avdecthreadtype() { return int_value(OPTION_AVDECTHREADTYPE); }
     int glswapinterval() { return int_value(OPTION_GLSWAPINTERVAL); }
+    bool renderbatching() { return bool_value(OPTION_RENDERBATCHING); }
+    bool skipidleframes() { return bool_value(OPTION_SKIPIDLEFRAMES); }
+    bool directrender() { return bool_value(OPTION_DIRECTRENDER); }
+    bool parallelrender() { return bool_value(OPTION_PARALLELRENDER); }
+    bool layercache() { return bool_value(OPTION_LAYERCACHE); }
+    int texturebudget() { return int_value(OPTION_TEXTUREBUDGET); }
+    bool easingtables() { return bool_value(OPTION_EASINGTABLES); }
 
     const char* layout() { return value(OPTION_LAYOUT); }
     const char* randomlayout() { return value(OPTION_RANDOMLAYOUT); }
@@ -251,6 +266,7 @@ public:
     
     bool metalock() { return bool_value(OPTION_METALOCK); }
     bool overwritexml() { return bool_value(OPTION_OVERWRITEXML); }
+    bool backgroundmetaimport() { return bool_value(OPTION_BACKGROUNDMETAIMPORT); }
     bool showparenthesis() { return bool_value(OPTION_SHOWPARENTHESIS); }
     bool showsquarebrackets() { return bool_value(OPTION_SHOWSQUAREBRACKETS); }
     
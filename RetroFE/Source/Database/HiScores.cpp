@@ -8,6 +8,7 @@
 #include "HiScores.h"
 #include "../Utility/Utils.h"
 #include "../Utility/Log.h"
+#include "../Graphics/ThreadPool.h"
 #include "minizip/unzip.h"
 #include "rapidxml.hpp"
 #include "rapidxml_utils.hpp"
@@ -292,7 +293,7 @@ bool HiScores::runHi2Txt(const std::string& gameName) {
 
 // Wrapper function to run hi2txt asynchronously
 void HiScores::runHi2TxtAsync(const std::string& gameName) {
-    std::thread([this, gameName]() {
+    ThreadPool::shared().post([this, gameName]() {
         try {
             if (runHi2Txt(gameName)) {
                 LOG_INFO("HiScores", "runHi2Txt executed successfully in the background for game " + gameName);
@@ -304,7 +305,7 @@ void HiScores::runHi2TxtAsync(const std::string& gameName) {
         } catch (...) {
             LOG_ERROR("HiScores", "Unknown exception in runHi2TxtAsync for game " + gameName);
         }
-        }).detach();
+        }, ThreadPool::PriorityBackground);
 }
 
 // Helper function to load the XML file content into a buffer
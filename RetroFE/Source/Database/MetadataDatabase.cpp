@@ -34,10 +34,24 @@
 #include <exception>
 #include <filesystem>
 #include <functional>
+#include <mutex>
 
 
 namespace fs = std::filesystem;
 
+namespace
+{
+    // How long a connection waits for the other's lock, longer than any one list takes to commit
+    constexpr int busyTimeoutMs = 30000;
+
+    // A stopped import leaves nothing of its current list behind
+    void rollback(sqlite3* handle)
+    {
+        sqlite3_exec(handle, "ROLLBACK TRANSACTION;", nullptr, nullptr, nullptr);
+        LOG_INFO("Metadata", "Import stopped");
+    }
+}
+
 MetadataDatabase::MetadataDatabase(DB &db, Configuration &c)
     : config_(c)
     , db_(db)
@@ -45,7 +59,13 @@ MetadataDatabase::MetadataDatabase(DB &db, Configuration &c)
 
 }
 
-MetadataDatabase::~MetadataDatabase() = default;
+MetadataDatabase::~MetadataDatabase()
+{
+    stopImport_ = true;
+    if (importThread_.joinable()) {
+        importThread_.join();
+    }
+}
 
 bool MetadataDatabase::resetDatabase()
 {
@@ -54,9 +74,11 @@ bool MetadataDatabase::resetDatabase()
     sqlite3 *handle = db_.handle;
 
     LOG_INFO("Metadata", "Erasing");
+    snapshot_.close();
 
     std::string sql;
     sql.append("DROP TABLE IF EXISTS Meta;");
+    sql.append("DROP TABLE IF EXISTS MetaManifest;");
 
     rc = sqlite3_exec(handle, sql.c_str(), nullptr, nullptr, &error);
 
@@ -70,8 +92,11 @@ bool MetadataDatabase::resetDatabase()
     return initialize();
 }
 
-bool MetadataDatabase::initialize()
+bool MetadataDatabase::initialize(bool deferImport)
 {
+    if (openSnapshot()) {
+        return true;
+    }
     if(needsRefresh()) {
         int rc;
         char* error = nullptr;
@@ -94,6 +119,10 @@ bool MetadataDatabase::initialize()
         sql.append("rating TEXT NOT NULL DEFAULT '',");
         sql.append("score TEXT NOT NULL DEFAULT '');");
         sql.append("CREATE UNIQUE INDEX IF NOT EXISTS MetaUniqueId ON Meta(collectionName, name);");
+        sql.append("CREATE TABLE IF NOT EXISTS MetaManifest(");
+        sql.append("path TEXT PRIMARY KEY,");
+        sql.append("mtime INTEGER NOT NULL,");
+        sql.append("size INTEGER NOT NULL);");
 
         rc = sqlite3_exec(handle, sql.c_str(), nullptr, nullptr, &error);
 
@@ -103,12 +132,91 @@ bool MetadataDatabase::initialize()
             LOG_ERROR("Metadata", ss.str());
             return false;
         }
+        if (deferImport) {
+            importPending_ = true;
+        }
+        else {
+            importDirectory();
+            saveManifest();
+        }
+    }
+    return true;
+}
+
+bool MetadataDatabase::importPending() const
+{
+    return importPending_;
+}
+
+bool MetadataDatabase::isImporting() const
+{
+    return importing_;
+}
+
+// Runs the import deferred by initialize() on a worker thread. The name of
+// every collection whose list has been committed is queued for takeImported().
+void MetadataDatabase::startBackgroundImport()
+{
+    if (!importPending_ || importing_) {
+        return;
+    }
+    importPending_ = false;
+
+    // The import writes through a connection of its own, so its transactions
+    // never mix with the reads of the UI thread. Both wait for the other's
+    // locks instead of failing.
+    importDb_ = std::make_unique<DB>(db_.path());
+    if (!importDb_->initialize()) {
+        LOG_WARNING("Metadata", "Could not open a second database connection, importing now");
+        importDb_.reset();
         importDirectory();
+        saveManifest();
+        return;
     }
+    sqlite3_busy_timeout(importDb_->handle, busyTimeoutMs);
+    sqlite3_busy_timeout(db_.handle, busyTimeoutMs);
+    importing_ = true;
+
+    LOG_INFO("Metadata", "Importing metadata in the background");
+    importThread_ = std::thread([this]() {
+        importDirectory([this](const std::string& collectionName) {
+            std::scoped_lock lock(importedMutex_);
+            imported_.push_back(collectionName);
+        });
+        if (!stopImport_) {
+            saveManifest();
+            LOG_INFO("Metadata", "Background import finished");
+        }
+        importing_ = false;
+    });
+}
+
+sqlite3* MetadataDatabase::importHandle() const
+{
+    return importDb_ ? importDb_->handle : db_.handle;
+}
+
+bool MetadataDatabase::takeImported(std::vector<std::string>& collections)
+{
+    std::scoped_lock lock(importedMutex_);
+    if (imported_.empty()) {
+        return false;
+    }
+    collections.swap(imported_);
+    imported_.clear();
     return true;
 }
 
-bool MetadataDatabase::importDirectory()
+// The status property is read by the UI thread, so only set it while the
+// import is still blocking the splash screen
+void MetadataDatabase::setStatus(const std::string& status)
+{
+    if (!importing_) {
+        config_.setProperty("status", status);
+    }
+}
+
+bool MetadataDatabase::importDirectory(const std::function<void(const std::string&)>& onImported)
 {
     std::string hyperListPath = Utils::combinePath(Configuration::absolutePath, "meta", "hyperlist");
     std::string mameListPath = Utils::combinePath(Configuration::absolutePath, "meta", "mamelist");
@@ -123,6 +231,9 @@ bool MetadataDatabase::importDirectory()
             }
 
             for (const auto& entry : fs::directory_iterator(path)) {
+                if (stopImport_) {
+                    return;
+                }
                 if (fs::is_regular_file(entry) && entry.path().extension() == extension) {
                     std::string importFile = entry.path().string();
                     std::string basename = entry.path().stem().string();
@@ -130,6 +241,13 @@ bool MetadataDatabase::importDirectory()
 
                     LOG_INFO("Metadata", "Importing " + extension.substr(1) + ": " + importFile);
                     importFunc(importFile, collectionName);
+                    if (stopImport_) {
+                        return;
+                    }
+                    if (onImported) {
+                        // EmuArc lists name their collection inside the file
+                        onImported(extension == ".dat" ? "" : collectionName);
+                    }
                 }
             }
         };
@@ -144,15 +262,24 @@ bool MetadataDatabase::importDirectory()
 
 void MetadataDatabase::injectMetadata(CollectionInfo* collection)
 {
+    injectMetadata(collection->metadataType, collection->items);
+}
+
+void MetadataDatabase::injectMetadata(const std::string& metadataType, const std::vector<Item*>& items)
+{
+    if (snapshot_.isOpen()) {
+        snapshot_.injectMetadata(metadataType, items);
+        return;
+    }
+
     sqlite3* handle = db_.handle;
     int rc;
     sqlite3_stmt* stmt;
 
     // items into a hash to make it easily searchable
-    std::vector<Item*> const* items = &collection->items;
     std::map<std::string, Item*, std::less<>> itemMap;
 
-    for (auto* item : *items) {
+    for (auto* item : items) {
         itemMap.try_emplace(item->name, item);
     }
 
@@ -162,7 +289,7 @@ void MetadataDatabase::injectMetadata(CollectionInfo* collection)
         "FROM Meta WHERE collectionName=? ORDER BY title ASC;",
         -1, &stmt, nullptr);
 
-    sqlite3_bind_text(stmt, 1, collection->metadataType.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 1, metadataType.c_str(), -1, SQLITE_TRANSIENT);
 
     rc = sqlite3_step(stmt);
 
@@ -205,6 +332,37 @@ void MetadataDatabase::injectMetadata(CollectionInfo* collection)
     sqlite3_finalize(stmt);
 }
 
+bool MetadataDatabase::exportSnapshot()
+{
+    setStatus("Exporting metadata snapshot");
+    return MetadataSnapshot::write(db_.handle, Utils::combinePath(Configuration::absolutePath, "meta.snapshot"));
+}
+
+// With metaLock set the Meta table never changes, so serve lookups from the
+// exported snapshot instead of querying SQLite for every collection.
+bool MetadataDatabase::openSnapshot()
+{
+    bool metaLock = false;
+    config_.getProperty(OPTION_METALOCK, metaLock);
+    if (!metaLock)
+        return false;
+
+    fs::path snapshotPath = Utils::combinePath(Configuration::absolutePath, "meta.snapshot");
+    fs::path metaDbPath = Utils::combinePath(Configuration::absolutePath, "meta.db");
+
+    std::error_code ec;
+    if (!fs::exists(snapshotPath, ec))
+        return false;
+
+    // A snapshot older than meta.db was taken before the last import
+    if (fs::exists(metaDbPath, ec) && fs::last_write_time(snapshotPath, ec) < fs::last_write_time(metaDbPath, ec)) {
+        LOG_WARNING("Metadata", "Ignoring stale meta.snapshot, run -exportsnapshot to refresh it");
+        return false;
+    }
+
+    return snapshot_.open(snapshotPath.string());
+}
+
 bool MetadataDatabase::needsRefresh()
 {
     bool metaLock = false;
@@ -214,44 +372,141 @@ bool MetadataDatabase::needsRefresh()
 
     sqlite3* handle = db_.handle;
     sqlite3_stmt* stmt;
-    bool result;
+    int count = 0;
 
-    sqlite3_prepare_v2(handle, "SELECT COUNT(*) FROM Meta;", -1, &stmt, nullptr);
+    if (sqlite3_prepare_v2(handle, "SELECT COUNT(*) FROM Meta;", -1, &stmt, nullptr) != SQLITE_OK) {
+        return true;
+    }
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
 
-    if (int rc = sqlite3_step(stmt); rc == SQLITE_ROW) {
-        int count = sqlite3_column_int(stmt, 0);
+    if (count == 0) {
+        return true;
+    }
 
-        fs::path metaDbPath = Utils::combinePath(Configuration::absolutePath, "meta.db");
-        fs::path exePath;
+    fs::path metaDbPath = Utils::combinePath(Configuration::absolutePath, "meta.db");
+    fs::path exePath;
 
 #ifdef WIN32
-        exePath = Utils::combinePath(Configuration::absolutePath, "retrofe", "RetroFE.exe");
+    exePath = Utils::combinePath(Configuration::absolutePath, "retrofe", "RetroFE.exe");
 #else
-        exePath = Utils::combinePath(Configuration::absolutePath, "RetroFE");
-        if (!fs::exists(exePath)) {
-            exePath = Utils::combinePath(Configuration::absolutePath, "retrofe");
-        }
+    exePath = Utils::combinePath(Configuration::absolutePath, "RetroFE");
+    if (!fs::exists(exePath)) {
+        exePath = Utils::combinePath(Configuration::absolutePath, "retrofe");
+    }
 #endif
 
-        fs::file_time_type metaDbTime = fs::exists(metaDbPath) ? fs::last_write_time(metaDbPath) : fs::file_time_type::min();
-        fs::file_time_type exeTime = fs::exists(exePath) ? fs::last_write_time(exePath) : fs::file_time_type::min();
-        fs::file_time_type metadirTime = timeDir(Utils::combinePath(Configuration::absolutePath, "meta"));
-
-        result = (count == 0 || metaDbTime < metadirTime || exeTime < metadirTime) ? true : false;
+    // A new build may import differently
+    std::error_code ec;
+    fs::file_time_type metaDbTime = fs::last_write_time(metaDbPath, ec);
+    if (ec) {
+        return true;
+    }
+    if (fs::file_time_type exeTime = fs::last_write_time(exePath, ec); !ec && exeTime > metaDbTime) {
+        return true;
     }
-    else {
-        result = true;
+
+    return manifestChanged();
+}
+
+// The manifest holds the mtime of every directory below meta/ and of the list
+// files that get imported. Adding, removing or renaming anything changes the
+// mtime of its parent directory, so this costs one stat per directory and list
+// file instead of walking the whole tree.
+bool MetadataDatabase::manifestChanged()
+{
+    sqlite3* handle = db_.handle;
+    sqlite3_stmt* stmt;
+
+    // Parents were stored before their children, so the first mismatch is
+    // found top-down
+    if (sqlite3_prepare_v2(handle, "SELECT path, mtime, size FROM MetaManifest ORDER BY rowid;", -1, &stmt, nullptr) != SQLITE_OK) {
+        return true;
     }
 
+    bool changed = false;
+    bool empty = true;
+    while (!changed && sqlite3_step(stmt) == SQLITE_ROW) {
+        empty = false;
+        fs::path path = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        sqlite3_int64 mtime = sqlite3_column_int64(stmt, 1);
+        sqlite3_int64 size = sqlite3_column_int64(stmt, 2);
+
+        std::error_code ec;
+        fs::file_time_type time = fs::last_write_time(path, ec);
+        if (ec || static_cast<sqlite3_int64>(time.time_since_epoch().count()) != mtime) {
+            LOG_INFO("Metadata", "Changed: " + path.string());
+            changed = true;
+        }
+        else if (size >= 0 && static_cast<sqlite3_int64>(fs::file_size(path, ec)) != size) {
+            LOG_INFO("Metadata", "Changed: " + path.string());
+            changed = true;
+        }
+    }
     sqlite3_finalize(stmt);
 
-    return result;
+    return changed || empty;
+}
+
+void MetadataDatabase::saveManifest()
+{
+    sqlite3* handle = importHandle();
+    char* error = nullptr;
+    sqlite3_stmt* stmt;
+
+    if (sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION; DELETE FROM MetaManifest;", nullptr, nullptr, &error) != SQLITE_OK) {
+        std::string emsg = error ? error : "";
+        sqlite3_free(error);
+        LOG_WARNING("Metadata", "Could not update manifest: " + emsg);
+        return;
+    }
+    sqlite3_prepare_v2(handle, "INSERT OR REPLACE INTO MetaManifest (path, mtime, size) VALUES (?,?,?);", -1, &stmt, nullptr);
+
+    auto add = [&](const fs::path& path, bool isFile) {
+        std::error_code ec;
+        fs::file_time_type time = fs::last_write_time(path, ec);
+        if (ec)
+            return;
+        sqlite3_int64 size = isFile ? static_cast<sqlite3_int64>(fs::file_size(path, ec)) : -1;
+        sqlite3_bind_text(stmt, 1, path.string().c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(time.time_since_epoch().count()));
+        sqlite3_bind_int64(stmt, 3, size);
+        sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    };
+
+    fs::path metaPath = Utils::combinePath(Configuration::absolutePath, "meta");
+    std::error_code ec;
+    if (fs::is_directory(metaPath, ec)) {
+        add(metaPath, false);
+        for (auto it = fs::recursive_directory_iterator(metaPath, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->is_directory(ec)) {
+                add(it->path(), false);
+            }
+        }
+        // Files rewritten in place do not touch their directory, so track the
+        // lists that importDirectory() reads as well
+        for (const char* dir : { "hyperlist", "mamelist", "emuarc" }) {
+            fs::path listPath = metaPath / dir;
+            for (auto it = fs::directory_iterator(listPath, ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+                if (it->is_regular_file(ec)) {
+                    add(it->path(), true);
+                }
+            }
+            ec.clear();
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_exec(handle, "COMMIT TRANSACTION;", nullptr, nullptr, &error);
 }
 
 bool MetadataDatabase::importHyperlist(const std::string& hyperlistFile, const std::string& collectionName)
 {
     char* error = nullptr;
-    config_.setProperty("status", "Scraping data from \"" + hyperlistFile + "\"");
+    setStatus("Scraping data from \"" + hyperlistFile + "\"");
 
     std::ifstream file(hyperlistFile.c_str());
     if (!file) {
@@ -271,7 +526,7 @@ bool MetadataDatabase::importHyperlist(const std::string& hyperlistFile, const s
             return false;
         }
 
-        sqlite3* handle = db_.handle;
+        sqlite3* handle = importHandle();
         sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", nullptr, nullptr, &error);
 
         sqlite3_stmt* stmt;
@@ -282,6 +537,11 @@ bool MetadataDatabase::importHyperlist(const std::string& hyperlistFile, const s
         }
 
         for (auto const* game = root->first_node("game"); game; game = game->next_sibling("game")) {
+            if (stopImport_) {
+                sqlite3_finalize(stmt);
+                rollback(handle);
+                return false;
+            }
             const char* name = game->first_attribute("name") ? game->first_attribute("name")->value() : "";
             if (name[0] == '\0') continue;  
             
@@ -310,7 +570,7 @@ bool MetadataDatabase::importHyperlist(const std::string& hyperlistFile, const s
 
         sqlite3_finalize(stmt);
         sqlite3_exec(handle, "COMMIT TRANSACTION;", nullptr, nullptr, &error);
-        config_.setProperty("status", "Saving data from \"" + hyperlistFile + "\" to database");
+        setStatus("Saving data from \"" + hyperlistFile + "\" to database");
         return true;
     }
     catch (rapidxml::parse_error& e) {
@@ -333,9 +593,9 @@ bool MetadataDatabase::importMamelist(const std::string& filename, const std::st
     auto doc = std::make_unique<rapidxml::xml_document<>>();
     rapidxml::xml_node<> const* rootNode;
     char* error = nullptr;
-    sqlite3* handle = db_.handle;
+    sqlite3* handle = importHandle();
 
-    config_.setProperty("status", "Scraping data from \"" + filename + "\" (this will take a while)");
+    setStatus("Scraping data from \"" + filename + "\" (this will take a while)");
 
     LOG_INFO("Mamelist", "Importing mamelist file \"" + filename + "\" (this will take a while)");
     std::ifstream file(filename.c_str());
@@ -373,6 +633,11 @@ bool MetadataDatabase::importMamelist(const std::string& filename, const std::st
 
 
     for (rapidxml::xml_node<> const* game = rootNode->first_node(gameNodeName.c_str()); game; game = game->next_sibling()) {
+        if (stopImport_) {
+            sqlite3_finalize(stmt);
+            rollback(handle);
+            return false;
+        }
         rapidxml::xml_attribute<> const* nameNode = game->first_attribute("name");
         rapidxml::xml_attribute<> const* cloneOfXml = game->first_attribute("cloneof");
 
@@ -430,7 +695,7 @@ bool MetadataDatabase::importMamelist(const std::string& filename, const std::st
 
     sqlite3_finalize(stmt);
 
-    config_.setProperty("status", "Saving data from \"" + filename + "\" to database");
+    setStatus("Saving data from \"" + filename + "\" to database");
     if (sqlite3_exec(handle, "COMMIT TRANSACTION;", nullptr, nullptr, &error) != SQLITE_OK) {
         std::string emsg = error;
         LOG_ERROR("Metadata", "SQL Error closing transaction: " + emsg);
@@ -443,7 +708,7 @@ bool MetadataDatabase::importEmuArclist(const std::string& emuarclistFile)
 {
     char *error = nullptr;
 
-    config_.setProperty("status", "Scraping data from \"" + emuarclistFile + "\"");
+    setStatus("Scraping data from \"" + emuarclistFile + "\"");
     rapidxml::xml_document<> doc;
     std::ifstream file(emuarclistFile.c_str());
     std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
@@ -474,11 +739,15 @@ bool MetadataDatabase::importEmuArclist(const std::string& emuarclistFile)
         if(std::size_t pos = collectionName.find(" - "); pos != std::string::npos) {
             collectionName = collectionName.substr(0, pos);
         }
-        sqlite3 *handle = db_.handle;
+        sqlite3 *handle = importHandle();
         sqlite3_exec(handle, "BEGIN IMMEDIATE TRANSACTION;", nullptr, nullptr, &error);
         
 
         for(rapidxml::xml_node<> const *game = root->first_node("game"); game; game = game->next_sibling("game")) {
+            if (stopImport_) {
+                rollback(handle);
+                return false;
+            }
             rapidxml::xml_node<> const *descriptionXml = game->first_node("description");
             rapidxml::xml_node<> const *emuarcXml      = game->first_node("EmuArc");
             if (!emuarcXml) {
@@ -538,7 +807,7 @@ bool MetadataDatabase::importEmuArclist(const std::string& emuarclistFile)
                 sqlite3_finalize(stmt);
             }
         }
-        config_.setProperty("status", "Saving data from \"" + emuarclistFile + "\" to database");
+        setStatus("Saving data from \"" + emuarclistFile + "\" to database");
         sqlite3_exec(handle, "COMMIT TRANSACTION;", nullptr, nullptr, &error);
 
         return true;
@@ -559,23 +828,3 @@ bool MetadataDatabase::importEmuArclist(const std::string& emuarclistFile)
 
     return false;
 }
-
-
-fs::file_time_type MetadataDatabase::timeDir(const std::string& path)
-{
-    fs::file_time_type lastTime = fs::file_time_type::min();
-
-    for (const auto& entry : fs::recursive_directory_iterator(path)) {
-        if (!fs::is_regular_file(entry) && !fs::is_directory(entry)) {
-            continue;
-        }
-
-        auto currentFileTime = fs::last_write_time(entry);
-
-        if (currentFileTime > lastTime) {
-            lastTime = currentFileTime;
-        }
-    }
-
-    return lastTime;
-}
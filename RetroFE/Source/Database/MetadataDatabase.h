@@ -18,9 +18,16 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <filesystem>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "MetadataSnapshot.h"
 
 class DB;
+struct sqlite3;
 class Configuration;
 class CollectionInfo;
 class Item;
@@ -30,18 +37,37 @@ class MetadataDatabase
 public:
     MetadataDatabase(DB &db, Configuration &c);
     virtual ~MetadataDatabase();
-    bool initialize();
+    bool initialize(bool deferImport = false);
+    bool importPending() const;
+    void startBackgroundImport();
+    bool isImporting() const;
+    bool takeImported(std::vector<std::string>& collections);
     bool resetDatabase();
 
     void injectMetadata(CollectionInfo *collection);
+    void injectMetadata(const std::string& metadataType, const std::vector<Item*>& items);
     bool importHyperlist(const std::string& hyperlistFile, const std::string& collectionName);
     bool importMamelist(const std::string& filename, const std::string& collectionName);
     bool importEmuArclist(const std::string& filename);
+    bool exportSnapshot();
 
 private:
-    bool importDirectory();
+    bool importDirectory(const std::function<void(const std::string&)>& onImported = nullptr);
+    void setStatus(const std::string& status);
     bool needsRefresh();
-    std::filesystem::file_time_type timeDir(const std::string& path);
+    bool manifestChanged();
+    void saveManifest();
+    bool openSnapshot();
+    // The connection the imports write through, the background import has its own
+    sqlite3* importHandle() const;
+    MetadataSnapshot snapshot_;
+    std::thread importThread_;
+    std::unique_ptr<DB> importDb_;
+    std::atomic<bool> importing_{ false };
+    std::atomic<bool> stopImport_{ false };
+    bool importPending_ = false;
+    std::mutex importedMutex_;
+    std::vector<std::string> imported_;
     Configuration &config_;
     DB &db_;
 };
@@ -0,0 +1,365 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MetadataSnapshot.h"
+#include "../Collection/CollectionInfo.h"
+#include "../Collection/Item.h"
+#include "../Utility/Log.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sqlite3.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+MetadataSnapshot::~MetadataSnapshot()
+{
+    close();
+}
+
+bool MetadataSnapshot::write(sqlite3* handle, const std::string& path)
+{
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(handle,
+        "SELECT collectionName, name, title, year, manufacturer, developer, genre, players, ctrltype, buttons, joyways, cloneOf, rating, score "
+        "FROM Meta;",
+        -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("MetadataSnapshot", "Unable to read Meta table: " + std::string(sqlite3_errmsg(handle)));
+        return false;
+    }
+
+    // Column 0 is the collection, the remaining columns map 1:1 onto Field
+    using Row = std::array<uint32_t, FIELD_COUNT + 1>;
+    std::vector<Row> rows;
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> stringIndex;
+    std::vector<StringRef> stringRefs;
+
+    auto intern = [&](const unsigned char* text) {
+        std::string value = text ? reinterpret_cast<const char*>(text) : "";
+        auto [it, inserted] = stringIndex.try_emplace(value, static_cast<uint32_t>(stringRefs.size()));
+        if (inserted) {
+            stringRefs.push_back({ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size()) });
+            strings.append(value);
+            strings.push_back('\0');
+        }
+        return it->second;
+    };
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        Row row;
+        for (int i = 0; i <= FIELD_COUNT; ++i) {
+            row[i] = intern(sqlite3_column_text(stmt, i));
+        }
+        rows.push_back(row);
+    }
+    sqlite3_finalize(stmt);
+
+    auto view = [&](uint32_t index) {
+        return std::string_view(strings.data() + stringRefs[index].offset, stringRefs[index].length);
+    };
+
+    std::sort(rows.begin(), rows.end(), [&](const Row& a, const Row& b) {
+        if (a[0] != b[0])
+            return view(a[0]) < view(b[0]);
+        return view(a[1 + FIELD_NAME]) < view(b[1 + FIELD_NAME]);
+    });
+
+    std::vector<Collection> collections;
+    std::vector<Record> records;
+    records.reserve(rows.size());
+
+    for (const Row& row : rows) {
+        if (collections.empty() || row[0] != collections.back().name.offset) {
+            collections.push_back({ { row[0], 0 }, static_cast<uint32_t>(records.size()), 0 });
+        }
+        // Skip duplicate names; the unique index should prevent these anyway
+        if (collections.back().recordCount > 0 &&
+            records.back().fields[FIELD_NAME].offset == row[1 + FIELD_NAME]) {
+            continue;
+        }
+        Record record;
+        for (int f = 0; f < FIELD_COUNT; ++f) {
+            record.fields[f] = { row[1 + f], 0 };
+        }
+        records.push_back(record);
+        collections.back().recordCount++;
+    }
+
+    // Until now StringRef::offset held an index into stringRefs, resolve it
+    for (Collection& collection : collections) {
+        collection.name = stringRefs[collection.name.offset];
+    }
+    for (Record& record : records) {
+        for (StringRef& field : record.fields) {
+            field = stringRefs[field.offset];
+        }
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, magic_, sizeof(header.magic));
+    header.version = version_;
+    header.collectionCount = static_cast<uint32_t>(collections.size());
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.collectionsOffset = sizeof(Header);
+    header.recordsOffset = header.collectionsOffset + static_cast<uint32_t>(collections.size() * sizeof(Collection));
+    header.stringsOffset = header.recordsOffset + static_cast<uint32_t>(records.size() * sizeof(Record));
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+
+    // Write next to the target and rename so a reader never maps a partial file
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOG_ERROR("MetadataSnapshot", "Could not open \"" + tmpPath + "\" for writing");
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(collections.data()), collections.size() * sizeof(Collection));
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+        out.write(strings.data(), strings.size());
+        if (!out) {
+            LOG_ERROR("MetadataSnapshot", "Failed writing \"" + tmpPath + "\"");
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        LOG_ERROR("MetadataSnapshot", "Could not replace \"" + path + "\": " + ec.message());
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    LOG_INFO("MetadataSnapshot", "Wrote " + std::to_string(records.size()) + " entries in " +
+        std::to_string(collections.size()) + " collections to \"" + path + "\"");
+    return true;
+}
+
+bool MetadataSnapshot::open(const std::string& path)
+{
+    close();
+
+#ifdef WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    header_ = reinterpret_cast<const Header*>(data_);
+    if (!validate()) {
+        LOG_WARNING("MetadataSnapshot", "Ignoring invalid or outdated snapshot \"" + path + "\"");
+        close();
+        return false;
+    }
+    collections_ = reinterpret_cast<const Collection*>(data_ + header_->collectionsOffset);
+    records_ = reinterpret_cast<const Record*>(data_ + header_->recordsOffset);
+
+    LOG_INFO("MetadataSnapshot", "Mapped \"" + path + "\" (" + std::to_string(header_->recordCount) + " entries)");
+    return true;
+}
+
+void MetadataSnapshot::close()
+{
+#ifdef WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    }
+    if (file_) {
+        CloseHandle(static_cast<HANDLE>(file_));
+    }
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    header_ = nullptr;
+    collections_ = nullptr;
+    records_ = nullptr;
+}
+
+bool MetadataSnapshot::isOpen() const
+{
+    return data_ != nullptr;
+}
+
+bool MetadataSnapshot::validate() const
+{
+    if (std::memcmp(header_->magic, magic_, sizeof(magic_)) != 0 || header_->version != version_) {
+        return false;
+    }
+
+    auto fits = [this](uint64_t offset, uint64_t length) {
+        return offset <= size_ && length <= size_ - offset;
+    };
+
+    if (!fits(header_->collectionsOffset, uint64_t(header_->collectionCount) * sizeof(Collection)) ||
+        !fits(header_->recordsOffset, uint64_t(header_->recordCount) * sizeof(Record)) ||
+        !fits(header_->stringsOffset, header_->stringsSize) ||
+        header_->collectionsOffset % alignof(Collection) != 0 ||
+        header_->recordsOffset % alignof(Record) != 0) {
+        return false;
+    }
+
+    // Check every reference once here so lookups never need to
+    auto validRef = [this](const StringRef& ref) {
+        return uint64_t(ref.offset) + ref.length < header_->stringsSize;
+    };
+
+    auto const* collections = reinterpret_cast<const Collection*>(data_ + header_->collectionsOffset);
+    auto const* records = reinterpret_cast<const Record*>(data_ + header_->recordsOffset);
+
+    for (uint32_t i = 0; i < header_->collectionCount; ++i) {
+        const Collection& c = collections[i];
+        if (!validRef(c.name) || uint64_t(c.firstRecord) + c.recordCount > header_->recordCount) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header_->recordCount; ++i) {
+        for (const StringRef& ref : records[i].fields) {
+            if (!validRef(ref)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string_view MetadataSnapshot::str(const StringRef& ref) const
+{
+    return std::string_view(data_ + header_->stringsOffset + ref.offset, ref.length);
+}
+
+const MetadataSnapshot::Collection* MetadataSnapshot::findCollection(std::string_view name) const
+{
+    const Collection* begin = collections_;
+    const Collection* end = collections_ + header_->collectionCount;
+    const Collection* it = std::lower_bound(begin, end, name, [this](const Collection& c, std::string_view n) {
+        return str(c.name) < n;
+    });
+    if (it == end || str(it->name) != name) {
+        return nullptr;
+    }
+    return it;
+}
+
+void MetadataSnapshot::injectMetadata(CollectionInfo* collection) const
+{
+    injectMetadata(collection->metadataType, collection->items);
+}
+
+void MetadataSnapshot::injectMetadata(const std::string& metadataType, const std::vector<Item*>& items) const
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    const Collection* entry = findCollection(metadataType);
+    if (!entry || entry->recordCount == 0) {
+        return;
+    }
+
+    const Record* begin = records_ + entry->firstRecord;
+    const Record* end = begin + entry->recordCount;
+
+    // Like the SQLite path, only the first item of a name gets its metadata
+    std::unordered_set<std::string_view> seen;
+    for (Item* item : items) {
+        if (!seen.insert(item->name).second) {
+            continue;
+        }
+        const Record* it = std::lower_bound(begin, end, std::string_view(item->name), [this](const Record& r, std::string_view n) {
+            return str(r.fields[FIELD_NAME]) < n;
+        });
+        if (it == end || str(it->fields[FIELD_NAME]) != item->name) {
+            continue;
+        }
+
+        item->fullTitle = str(it->fields[FIELD_TITLE]);
+        item->title = item->fullTitle;
+        item->year = str(it->fields[FIELD_YEAR]);
+        item->manufacturer = str(it->fields[FIELD_MANUFACTURER]);
+        item->developer = str(it->fields[FIELD_DEVELOPER]);
+        item->genre = str(it->fields[FIELD_GENRE]);
+        item->numberPlayers = str(it->fields[FIELD_PLAYERS]);
+        item->numberButtons = str(it->fields[FIELD_BUTTONS]);
+        item->ctrlType = str(it->fields[FIELD_CTRLTYPE]);
+        item->joyWays = str(it->fields[FIELD_JOYWAYS]);
+        item->cloneof = str(it->fields[FIELD_CLONEOF]);
+        item->rating = str(it->fields[FIELD_RATING]);
+        item->score = str(it->fields[FIELD_SCORE]);
+    }
+}
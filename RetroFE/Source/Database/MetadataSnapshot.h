@@ -0,0 +1,121 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct sqlite3;
+class CollectionInfo;
+class Item;
+
+// Read-only, memory-mapped copy of the Meta table.
+//
+// Layout (native byte order, section offsets relative to the start of the file,
+// string offsets relative to the string table):
+//   Header
+//   Collection[collectionCount]   sorted by name
+//   Record[recordCount]           grouped by collection, sorted by name
+//   string table                  NUL terminated, de-duplicated
+class MetadataSnapshot
+{
+public:
+    enum Field
+    {
+        FIELD_NAME,
+        FIELD_TITLE,
+        FIELD_YEAR,
+        FIELD_MANUFACTURER,
+        FIELD_DEVELOPER,
+        FIELD_GENRE,
+        FIELD_PLAYERS,
+        FIELD_CTRLTYPE,
+        FIELD_BUTTONS,
+        FIELD_JOYWAYS,
+        FIELD_CLONEOF,
+        FIELD_RATING,
+        FIELD_SCORE,
+        FIELD_COUNT
+    };
+
+    MetadataSnapshot() = default;
+    ~MetadataSnapshot();
+    MetadataSnapshot(const MetadataSnapshot&) = delete;
+    MetadataSnapshot& operator=(const MetadataSnapshot&) = delete;
+
+    static bool write(sqlite3* handle, const std::string& path);
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Copies metadata into every item of the collection that has a row in the
+    // snapshot. Strings are only materialised for items that match.
+    void injectMetadata(CollectionInfo* collection) const;
+    void injectMetadata(const std::string& metadataType, const std::vector<Item*>& items) const;
+
+private:
+    struct StringRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Header
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t collectionCount;
+        uint32_t recordCount;
+        uint32_t collectionsOffset;
+        uint32_t recordsOffset;
+        uint32_t stringsOffset;
+        uint32_t stringsSize;
+        uint32_t reserved;
+    };
+
+    struct Collection
+    {
+        StringRef name;
+        uint32_t  firstRecord;
+        uint32_t  recordCount;
+    };
+
+    struct Record
+    {
+        StringRef fields[FIELD_COUNT];
+    };
+
+    static constexpr char     magic_[8] = { 'R', 'F', 'E', 'M', 'E', 'T', 'A', '\0' };
+    static constexpr uint32_t version_ = 1;
+
+    bool validate() const;
+    std::string_view str(const StringRef& ref) const;
+    const Collection* findCollection(std::string_view name) const;
+
+    const char* data_ = nullptr;
+    size_t      size_ = 0;
+    const Header*     header_ = nullptr;
+    const Collection* collections_ = nullptr;
+    const Record*     records_ = nullptr;
+#ifdef WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
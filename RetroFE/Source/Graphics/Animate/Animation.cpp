@@ -14,6 +14,8 @@
  * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Animation.h"
+#include "Timeline.h"
+#include "Tween.h"
 #include <string>
 #include <memory>
 #include <vector>
@@ -47,10 +49,14 @@ Animation::~Animation()
 
 void Animation::Push(std::shared_ptr<TweenSet> set) {
     animationVector_.push_back(set);
+    std::lock_guard<std::mutex> lock(timelinesMutex_);
+    timelines_.clear();
 }
 
 void Animation::Clear() {
     animationVector_.clear();
+    std::lock_guard<std::mutex> lock(timelinesMutex_);
+    timelines_.clear();
 }
 
 std::shared_ptr<TweenSet> Animation::tweenSet(unsigned int index) {
@@ -66,3 +72,26 @@ std::shared_ptr<TweenSet> Animation::tweenSet(unsigned int index) {
 size_t Animation::size() const {
     return animationVector_.size();
 }
+
+std::shared_ptr<const Timeline> Animation::timeline(int playlist) {
+    std::lock_guard<std::mutex> lock(timelinesMutex_);
+    if (timelines_.empty()) {
+        filtered_ = false;
+        for (const auto& set : animationVector_) {
+            for (unsigned int i = 0; set && i < set->size(); ++i) {
+                const Tween* tween = set->getTween(i);
+                filtered_ |= tween && !tween->playlistFilter.empty();
+            }
+        }
+    }
+
+    // Without filters every playlist plays the same timeline
+    int key = filtered_ ? playlist : 0;
+    for (const auto& [timelinePlaylist, timeline] : timelines_) {
+        if (timelinePlaylist == key) {
+            return timeline;
+        }
+    }
+    timelines_.emplace_back(key, std::make_shared<const Timeline>(*this, key));
+    return timelines_.back().second;
+}
@@ -20,6 +20,10 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
+
+class Timeline;
 
 class Animation
 {
@@ -33,6 +37,12 @@ public:
     std::vector<TweenSet *> *tweenSets();
     std::shared_ptr<TweenSet> tweenSet(unsigned int index);
     size_t size() const;
+    // The sets laid out as one timeline. Animations with playlist filters get
+    // one for each playlist, built the first time it plays.
+    std::shared_ptr<const Timeline> timeline(int playlist);
 private:
     std::vector<std::shared_ptr<TweenSet>> animationVector_;
+    std::vector<std::pair<int, std::shared_ptr<const Timeline>>> timelines_; // by playlist, cleared by Push and Clear
+    bool filtered_{ false };
+    std::mutex timelinesMutex_;
 };
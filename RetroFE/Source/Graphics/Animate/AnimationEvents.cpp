@@ -15,9 +15,49 @@
  */
 
 #include "AnimationEvents.h"
+#include "../../Utility/Log.h"
 #include <string>
 #include <memory>
-#include <map>
+
+namespace
+{
+    const char* eventNames[ANIMATION_EVENT_COUNT] = {
+        "enter",
+        "exit",
+        "idle",
+        "menuIdle",
+        "menuScroll",
+        "playlistScroll",
+        "highlightEnter",
+        "highlightExit",
+        "menuEnter",
+        "menuExit",
+        "gameEnter",
+        "gameExit",
+        "playlistEnter",
+        "playlistExit",
+        "playlistNextEnter",
+        "playlistNextExit",
+        "playlistPrevEnter",
+        "playlistPrevExit",
+        "menuJumpEnter",
+        "menuJumpExit",
+        "attractEnter",
+        "attract",
+        "attractExit",
+        "jukeboxJump",
+        "gameInfoEnter",
+        "gameInfoExit",
+        "collectionInfoEnter",
+        "collectionInfoExit",
+        "buildInfoEnter",
+        "buildInfoExit",
+        "menuActionInputEnter",
+        "menuActionInputExit",
+        "menuActionSelectEnter",
+        "menuActionSelectExit"
+    };
+}
 
 AnimationEvents::AnimationEvents() = default;
 
@@ -26,33 +66,55 @@ AnimationEvents::~AnimationEvents()
     clear();
 }
 
-std::shared_ptr<Animation> AnimationEvents::getAnimation(const std::string& tween)
+std::shared_ptr<Animation> AnimationEvents::getAnimation(AnimationEvent event)
 {
-    return getAnimation(tween, -1);
+    return getAnimation(event, -1);
 }
 
-std::shared_ptr<Animation> AnimationEvents::getAnimation(const std::string& tween, int index)
+std::shared_ptr<Animation> AnimationEvents::getAnimation(AnimationEvent event, int index)
 {
-    if (animationMap_.find(tween) == animationMap_.end())
-        animationMap_[tween][-1] = std::make_shared<Animation>();
+    if (event < 0 || event >= ANIMATION_EVENT_COUNT)
+        return nullptr;
 
-    if (animationMap_[tween].find(index) == animationMap_[tween].end())
-        index = -1;
+    if (index >= 0 && index < indexCount && !indexedAnimations_.empty()) {
+        const std::shared_ptr<Animation>& animation = indexedAnimations_[event * indexCount + index];
+        if (animation)
+            return animation;
+    }
 
-    return animationMap_[tween][index];
+    if (!animations_[event])
+        animations_[event] = std::make_shared<Animation>();
+    return animations_[event];
 }
 
-void AnimationEvents::setAnimation(const std::string& tween, int index, std::shared_ptr<Animation> animation)
+void AnimationEvents::setAnimation(AnimationEvent event, int index, std::shared_ptr<Animation> animation)
 {
-    animationMap_[tween][index] = std::move(animation);
+    if (event < 0 || event >= ANIMATION_EVENT_COUNT)
+        return;
+
+    if (index == -1) {
+        animations_[event] = std::move(animation);
+    }
+    else if (index >= 0 && index < indexCount) {
+        if (indexedAnimations_.empty())
+            indexedAnimations_.resize(ANIMATION_EVENT_COUNT * indexCount);
+        indexedAnimations_[event * indexCount + index] = std::move(animation);
+    }
+    else {
+        LOG_WARNING("AnimationEvents", "Ignoring " + std::string(eventNames[event]) + " animation for menu index " + std::to_string(index));
+    }
 }
 
 void AnimationEvents::clear()
 {
-    animationMap_.clear(); // std::unique_ptr will automatically clean up
+    for (auto& animation : animations_)
+        animation.reset();
+    indexedAnimations_.clear();
 }
 
-// Getter for animationMap_
-const std::map<std::string, std::map<int, std::shared_ptr<Animation>>>& AnimationEvents::getAnimationMap() const {
-    return animationMap_;
-}
\ No newline at end of file
+const char* AnimationEvents::eventName(AnimationEvent event)
+{
+    if (event < 0 || event >= ANIMATION_EVENT_COUNT)
+        return "";
+    return eventNames[event];
+}
@@ -17,24 +17,31 @@
 
 #include "Tween.h"
 #include "Animation.h"
-#include <string>
+#include "TweenTypes.h"
+#include <array>
 #include <vector>
-#include <map>
 #include <memory> // Include memory for std::shared_ptr
 
+// The animations of a component by event and menu index, looked up by
+// indexing instead of by name
 class AnimationEvents {
 public:
     AnimationEvents();
     ~AnimationEvents();
 
-    std::shared_ptr<Animation> getAnimation(const std::string& tween);
-    std::shared_ptr<Animation> getAnimation(const std::string& tween, int index);
-    void setAnimation(const std::string& tween, int index, std::shared_ptr<Animation> animation);
+    std::shared_ptr<Animation> getAnimation(AnimationEvent event);
+    // Falls back to the animation for any menu index
+    std::shared_ptr<Animation> getAnimation(AnimationEvent event, int index);
+    // Index -1 is for any menu index
+    void setAnimation(AnimationEvent event, int index, std::shared_ptr<Animation> animation);
     void clear();
 
-    // Getter for animationMap_
-    const std::map<std::string, std::map<int, std::shared_ptr<Animation>>>& getAnimationMap() const;
+    static const char* eventName(AnimationEvent event);
 
 private:
-    std::map<std::string, std::map<int, std::shared_ptr<Animation>>> animationMap_;
+    static constexpr int indexCount = MENU_INDEX_HIGH + 1;
+
+    std::array<std::shared_ptr<Animation>, ANIMATION_EVENT_COUNT> animations_;
+    // Event x menu index, only allocated when a layout uses menu indexes
+    std::vector<std::shared_ptr<Animation>> indexedAnimations_;
 };
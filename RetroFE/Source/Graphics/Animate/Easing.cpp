@@ -0,0 +1,67 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Easing.h"
+#include "../../Utility/Log.h"
+#include <cstdio>
+#include <string>
+
+std::array<std::array<float, Easing::tableIntervals + 1>, Easing::algorithmCount> Easing::samples_;
+std::array<const float*, Easing::algorithmCount> Easing::tables_ = {};
+
+void Easing::setTables(bool enabled)
+{
+    tables_.fill(nullptr);
+    if (!enabled) {
+        return;
+    }
+
+    // Measured between the samples, where the interpolation is furthest off
+    constexpr int checksPerInterval = 16;
+    int baked = 0;
+    int analyticCurves = 0;
+    float largestError = 0;
+    for (int type = 0; type < algorithmCount; ++type) {
+        auto algorithm = static_cast<TweenAlgorithm>(type);
+        if (algorithm == LINEAR) {
+            continue;
+        }
+
+        std::array<float, tableIntervals + 1>& samples = samples_[type];
+        for (int i = 0; i <= tableIntervals; ++i) {
+            samples[i] = analytic(algorithm, static_cast<float>(i) / tableIntervals);
+        }
+
+        float error = 0;
+        for (int i = 0; i < tableIntervals * checksPerInterval; ++i) {
+            float p = static_cast<float>(i) / (tableIntervals * checksPerInterval);
+            error = std::max(error, std::abs(lookup(samples.data(), p) - analytic(algorithm, p)));
+        }
+
+        if (error <= tableTolerance) {
+            tables_[type] = samples.data();
+            largestError = std::max(largestError, error);
+            ++baked;
+        }
+        else {
+            ++analyticCurves;
+        }
+    }
+
+    char error[32];
+    snprintf(error, sizeof(error), "%.2e", largestError);
+    LOG_INFO("Easing", "Using tables for " + std::to_string(baked) + " easings, off by at most " + error +
+        ", " + std::to_string(analyticCurves) + " stay analytic");
+}
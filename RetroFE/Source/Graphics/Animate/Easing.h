@@ -0,0 +1,158 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "TweenTypes.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Easing curves over the progress of a tween, 0 at its start and 1 at its end.
+// They return how much of the change is applied at that point.
+//
+// With tables enabled, the curves are sampled once and interpolated from then
+// on. A curve the samples can not follow closely enough, such as the vertical
+// end of the circular ones, stays analytic.
+class Easing
+{
+public:
+    static constexpr int tableIntervals = 1024;
+    // The change a table may be off by, as a fraction of the whole change
+    static constexpr float tableTolerance = 0.0001f;
+
+    static void setTables(bool enabled);
+    // Nullptr when the curve is evaluated analytically
+    static const float* table(TweenAlgorithm type) { return tables_[type]; }
+
+    static float lookup(const float* table, float p)
+    {
+        float x = std::min(std::max(p, 0.0f), 1.0f) * tableIntervals;
+        int index = std::min(static_cast<int>(x), tableIntervals - 1);
+        return table[index] + (table[index + 1] - table[index]) * (x - static_cast<float>(index));
+    }
+
+    static float apply(TweenAlgorithm type, float p)
+    {
+        if (const float* samples = tables_[type]) {
+            return lookup(samples, p);
+        }
+        return analytic(type, p);
+    }
+
+    static float analytic(TweenAlgorithm type, float p)
+    {
+        switch (type) {
+        case EASE_IN_QUADRATIC:      return inQuadratic(p);
+        case EASE_OUT_QUADRATIC:     return outQuadratic(p);
+        case EASE_INOUT_QUADRATIC:   return inOutQuadratic(p);
+        case EASE_IN_CUBIC:          return inCubic(p);
+        case EASE_OUT_CUBIC:         return outCubic(p);
+        case EASE_INOUT_CUBIC:       return inOutCubic(p);
+        case EASE_IN_QUARTIC:        return inQuartic(p);
+        case EASE_OUT_QUARTIC:       return outQuartic(p);
+        case EASE_INOUT_QUARTIC:     return inOutQuartic(p);
+        case EASE_IN_QUINTIC:        return inQuintic(p);
+        case EASE_OUT_QUINTIC:       return outQuintic(p);
+        case EASE_INOUT_QUINTIC:     return inOutQuintic(p);
+        case EASE_IN_SINE:           return inSine(p);
+        case EASE_OUT_SINE:          return outSine(p);
+        case EASE_INOUT_SINE:        return inOutSine(p);
+        case EASE_IN_EXPONENTIAL:    return inExponential(p);
+        case EASE_OUT_EXPONENTIAL:   return outExponential(p);
+        case EASE_INOUT_EXPONENTIAL: return inOutExponential(p);
+        case EASE_IN_CIRCULAR:       return inCircular(p);
+        case EASE_OUT_CIRCULAR:      return outCircular(p);
+        case EASE_INOUT_CIRCULAR:    return inOutCircular(p);
+        case LINEAR:
+        default:                     return linear(p);
+        }
+    }
+
+    static float linear(float p) { return p; }
+
+    static float inQuadratic(float p) { return p * p; }
+    static float outQuadratic(float p) { return -p * (p - 2); }
+    static float inOutQuadratic(float p)
+    {
+        p *= 2;
+        if (p < 1) return p * p / 2;
+        p -= 1;
+        return -(p * (p - 2) - 1) / 2;
+    }
+
+    static float inCubic(float p) { return p * p * p; }
+    static float outCubic(float p) { p -= 1; return p * p * p + 1; }
+    static float inOutCubic(float p)
+    {
+        p *= 2;
+        if (p < 1) return p * p * p / 2;
+        p -= 2;
+        return (p * p * p + 2) / 2;
+    }
+
+    static float inQuartic(float p) { return p * p * p * p; }
+    static float outQuartic(float p) { p -= 1; return -(p * p * p * p - 1); }
+    static float inOutQuartic(float p)
+    {
+        p *= 2;
+        if (p < 1) return p * p * p * p / 2;
+        p -= 2;
+        return -(p * p * p * p - 2) / 2;
+    }
+
+    static float inQuintic(float p) { return p * p * p * p * p; }
+    static float outQuintic(float p) { p -= 1; return p * p * p * p * p + 1; }
+    static float inOutQuintic(float p)
+    {
+        p *= 2;
+        if (p < 1) return p * p * p * p * p / 2;
+        p -= 2;
+        return (p * p * p * p * p + 2) / 2;
+    }
+
+    static float inSine(float p) { return 1 - std::cos(p * halfPi); }
+    static float outSine(float p) { return std::sin(p * halfPi); }
+    static float inOutSine(float p) { return -(std::cos(p * pi) - 1) / 2; }
+
+    static float inExponential(float p) { return std::exp2(10 * (p - 1)); }
+    static float outExponential(float p) { return 1 - std::exp2(-10 * p); }
+    static float inOutExponential(float p)
+    {
+        p *= 2;
+        if (p < 1) return std::exp2(10 * (p - 1)) / 2;
+        p -= 1;
+        return (2 - std::exp2(-10 * p)) / 2;
+    }
+
+    static float inCircular(float p) { return 1 - std::sqrt(1 - p * p); }
+    static float outCircular(float p) { p -= 1; return std::sqrt(1 - p * p); }
+    static float inOutCircular(float p)
+    {
+        p *= 2;
+        if (p < 1) return (1 - std::sqrt(1 - p * p)) / 2;
+        p -= 2;
+        return (std::sqrt(1 - p * p) + 1) / 2;
+    }
+
+private:
+    static constexpr int algorithmCount = EASE_INOUT_CIRCULAR + 1;
+
+    static std::array<std::array<float, tableIntervals + 1>, algorithmCount> samples_;
+    static std::array<const float*, algorithmCount> tables_;
+
+    static constexpr float pi = 3.14159265358979323846f;
+    static constexpr float halfPi = pi / 2;
+};
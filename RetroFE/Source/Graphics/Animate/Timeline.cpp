@@ -0,0 +1,87 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Timeline.h"
+#include "Animation.h"
+#include "Easing.h"
+#include "Tween.h"
+#include <algorithm>
+
+Timeline::Timeline(Animation& animation, int playlist)
+{
+    constexpr int propertyCount = TWEEN_PROPERTY_RESTART + 1;
+    int channelOf[propertyCount];
+    std::fill(channelOf, channelOf + propertyCount, -1);
+
+    for (unsigned int index = 0; index < animation.size(); ++index) {
+        std::shared_ptr<TweenSet> set = animation.tweenSet(index);
+        if (!set) {
+            continue;
+        }
+
+        // Same rules as a set played on its own: a later tween of a property
+        // overrides an earlier one, and the set lasts as long as its longest
+        const Tween* last[propertyCount] = {};
+        double setDuration = 0;
+        for (unsigned int i = 0; i < set->size(); ++i) {
+            const Tween* tween = set->getTween(i);
+            if (!tween || !tween->appliesTo(playlist)) {
+                continue;
+            }
+            setDuration = std::max(setDuration, tween->duration);
+            last[tween->property] = tween;
+        }
+
+        for (int property = 0; property < propertyCount; ++property) {
+            const Tween* tween = last[property];
+            if (!tween || tween->property == TWEEN_PROPERTY_NOP) {
+                continue;
+            }
+            if (channelOf[property] < 0) {
+                channelOf[property] = static_cast<int>(channels_.size());
+                channels_.push_back({ tween->property, !tween->startDefined, {} });
+            }
+
+            // A tween without a start value starts where the previous set left
+            // the property
+            Channel& channel = channels_[channelOf[property]];
+            double start = tween->getStart();
+            if (!tween->startDefined && !channel.segments.empty()) {
+                start = channel.segments.back().end;
+            }
+            channel.segments.push_back({ duration_, tween->duration, tween->getType(), start, tween->getEnd() });
+        }
+
+        duration_ += setDuration;
+    }
+}
+
+const Timeline::Segment* Timeline::Channel::segmentAt(double time) const
+{
+    auto next = std::upper_bound(segments.begin(), segments.end(), time,
+        [](double t, const Segment& segment) { return t < segment.begin; });
+    return next == segments.begin() ? nullptr : &*(next - 1);
+}
+
+double Timeline::Channel::value(const Segment& segment, double time, double from) const
+{
+    double start = (fromStart && &segment == &segments.front()) ? from : segment.start;
+    // A tween without a duration holds its start value
+    if (segment.duration <= 0) {
+        return start;
+    }
+    double progress = std::min((time - segment.begin) / segment.duration, 1.0);
+    return start + (segment.end - start) * Easing::apply(segment.type, static_cast<float>(progress));
+}
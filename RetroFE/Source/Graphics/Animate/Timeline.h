@@ -0,0 +1,60 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "TweenTypes.h"
+#include <vector>
+
+class Animation;
+
+// The sets of an animation laid out on one time line.
+//
+// Each animated property gets a channel of segments, one per set that tweens
+// it, starting where the sets before it end. Evaluating a channel at any time
+// is a binary search for its segment and one interpolation, so playing the
+// animation never steps from set to set.
+class Timeline
+{
+public:
+    struct Segment
+    {
+        double         begin;
+        double         duration;
+        TweenAlgorithm type;
+        double         start;
+        double         end;
+    };
+
+    struct Channel
+    {
+        TweenProperty        property;
+        bool                 fromStart; // the first segment starts from the value the animation started with
+        std::vector<Segment> segments;  // by begin
+
+        // Nullptr before the first segment, the property is left alone until then
+        const Segment* segmentAt(double time) const;
+        double value(const Segment& segment, double time, double from) const;
+    };
+
+    // Only the tweens that apply to the playlist are laid out
+    Timeline(Animation& animation, int playlist);
+    double duration() const { return duration_; }
+    const std::vector<Channel>& channels() const { return channels_; }
+
+private:
+    std::vector<Channel> channels_;
+    double duration_{ 0 };
+};
@@ -14,10 +14,9 @@
  * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Tween.h"
+#include "Easing.h"
 #include "../../Utility/Log.h"
 #include <algorithm>
-#define _USE_MATH_DEFINES
-#include <math.h>
 #include <string>
 
 std::map<std::string, TweenAlgorithm, std::less<>> Tween::tweenTypeMap_ = {
@@ -71,14 +70,59 @@ std::map<std::string, TweenProperty, std::less<>> Tween::tweenPropertyMap_ = {
     {"restart", TWEEN_PROPERTY_RESTART}
 };
 
+std::map<std::string, int, std::less<>> Tween::playlistIds_ = { {"", 0} };
+std::mutex Tween::playlistIdsMutex_;
+
 Tween::Tween(TweenProperty property, TweenAlgorithm type, double start, double end, double duration, const std::string& playlistFilter)
     : property(property)
     , duration(duration)
-    , playlistFilter(playlistFilter)
     , type(type)
 	, start(start)
     , end(end)
 {
+    // The comma separated filter is parsed once, not on every frame
+    size_t begin = 0;
+    while (begin < playlistFilter.size()) {
+        size_t comma = playlistFilter.find(',', begin);
+        if (comma == std::string::npos) {
+            comma = playlistFilter.size();
+        }
+        if (comma > begin) {
+            this->playlistFilter.push_back(playlistId(std::string_view(playlistFilter).substr(begin, comma - begin)));
+        }
+        begin = comma + 1;
+    }
+}
+
+void Tween::reset(TweenProperty newProperty, TweenAlgorithm newType, double newStart, double newEnd, double newDuration)
+{
+    property = newProperty;
+    type = newType;
+    start = newStart;
+    end = newEnd;
+    duration = newDuration;
+    startDefined = true;
+    playlistFilter.clear();
+}
+
+int Tween::playlistId(std::string_view name)
+{
+    std::lock_guard<std::mutex> lock(playlistIdsMutex_);
+    auto it = playlistIds_.find(name);
+    if (it != playlistIds_.end()) {
+        return it->second;
+    }
+    int id = static_cast<int>(playlistIds_.size());
+    playlistIds_.emplace(std::string(name), id);
+    return id;
+}
+
+bool Tween::appliesTo(int playlist) const
+{
+    if (playlistFilter.empty() || playlist == 0) {
+        return true;
+    }
+    return std::find(playlistFilter.begin(), playlistFilter.end(), playlist) != playlistFilter.end();
 }
 
 
@@ -121,258 +165,6 @@ float Tween::animate(double elapsedTime, double startValue) const
 //todo: SDL likes floats, consider having casting being performed elsewhere
 float Tween::animateSingle(TweenAlgorithm type, double start, double end, double duration, double elapsedTime)
 {
-    double a = start;
-    double b = end - start;
-    double result = 0;
-
-    switch(type) {
-    case EASE_IN_QUADRATIC:
-        result = easeInQuadratic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_QUADRATIC:
-        result = easeOutQuadratic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_QUADRATIC:
-        result = easeInOutQuadratic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_IN_CUBIC:
-        result = easeInCubic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_CUBIC:
-        result = easeOutCubic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_CUBIC:
-        result = easeInOutCubic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_IN_QUARTIC:
-        result = easeInQuartic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_QUARTIC:
-        result = easeOutQuartic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_QUARTIC:
-        result = easeInOutQuartic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_IN_QUINTIC:
-        result = easeInQuintic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_QUINTIC:
-        result = easeOutQuintic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_QUINTIC:
-        result = easeInOutQuintic(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_IN_SINE:
-        result = easeInSine(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_SINE:
-        result = easeOutSine(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_SINE:
-        result = easeInOutSine(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_IN_EXPONENTIAL:
-        result = easeInExponential(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_EXPONENTIAL:
-        result = easeOutExponential(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_EXPONENTIAL:
-        result = easeInOutExponential(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_IN_CIRCULAR:
-        result = easeInCircular(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_OUT_CIRCULAR:
-        result = easeOutCircular(elapsedTime, duration, a, b);
-        break;
-
-    case EASE_INOUT_CIRCULAR:
-        result = easeInOutCircular(elapsedTime, duration, a, b);
-        break;
-
-    case LINEAR:
-    default:
-        result = linear(elapsedTime, duration, a, b);
-        break;
-    }
-
-    return static_cast<float>(result);
-
-}
-
-double Tween::linear(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    return c*t/d + b;
-};
-
-double Tween::easeInQuadratic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    return c*t*t + b;
-};
-
-double Tween::easeOutQuadratic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    return -c * t*(t-2) + b;
-};
-
-double Tween::easeInOutQuadratic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d/2;
-    if (t < 1) return c/2*t*t + b;
-    t--;
-    return -c/2 * (t*(t-2) - 1) + b;
-};
-
-double Tween::easeInCubic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    return c*t*t*t + b;
-};
-
-double Tween::easeOutCubic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    t--;
-    return c*(t*t*t + 1) + b;
-};
-
-double Tween::easeInOutCubic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d/2;
-    if (t < 1) return c/2*t*t*t + b;
-    t -= 2;
-    return c/2*(t*t*t + 2) + b;
-};
-
-double Tween::easeInQuartic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    return c*t*t*t*t + b;
-};
-
-double Tween::easeOutQuartic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    t--;
-    return -c * (t*t*t*t - 1) + b;
-};
-
-double Tween::easeInOutQuartic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d/2;
-    if (t < 1) return c/2*t*t*t*t + b;
-    t -= 2;
-    return -c/2 * (t*t*t*t - 2) + b;
-};
-
-double Tween::easeInQuintic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    return c*t*t*t*t*t + b;
-};
-
-
-double Tween::easeOutQuintic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d;
-    t--;
-    return c*(t*t*t*t*t + 1) + b;
-};
-
-double Tween::easeInOutQuintic(double t, double d, double b, double c)
-{
-    if(d == 0) return b;
-    t /= d/2;
-    if (t < 1) return c/2*t*t*t*t*t + b;
-    t -= 2;
-    return c/2*(t*t*t*t*t + 2) + b;
-};
-
-double Tween::easeInSine(double t, double d, double b, double c)
-{
-    return -c * cos(t/d * (M_PI/2)) + c + b;
-};
-
-double Tween::easeOutSine(double t, double d, double b, double c)
-{
-    return c * sin(t/d * (M_PI/2)) + b;
-};
-
-double Tween::easeInOutSine(double t, double d, double b, double c)
-{
-    return -c/2 * (cos( M_PI*t/d) - 1) + b;
-};
-
-double Tween::easeInExponential(double t, double d, double b, double c)
-{
-    return c * pow( 2, 10 * (t/d - 1) ) + b;
-};
-
-double Tween::easeOutExponential(double t, double d, double b, double c)
-{
-    return c * ( - pow( 2, -10 * t/d ) + 1 ) + b;
-};
-
-double Tween::easeInOutExponential(double t, double d, double b, double c)
-{
-    t /= d/2;
-    if (t < 1) return c/2 * pow( 2, 10 * (t - 1) ) + b;
-    t--;
-    return c/2 * ( -1* pow( 2, -10 * t) + 2 ) + b;
-};
-
-double Tween::easeInCircular(double t, double d, double b, double c)
-{
-    t /= d;
-    return -c * (sqrt(1 - t*t) - 1) + b;
-};
-
-
-double Tween::easeOutCircular(double t, double d, double b, double c)
-{
-    t /= d;
-    t--;
-    return c * sqrt(1 - t*t) + b;
-};
-
-double Tween::easeInOutCircular(double t, double d, double b, double c)
-{
-    t /= d/2;
-    if (t < 1) return -c/2 * (sqrt(1 - t*t) - 1) + b;
-    t -= 2;
-    return c/2 * (sqrt(1 - t*t) + 1) + b;
+    if (duration == 0) return static_cast<float>(start);
+    return static_cast<float>(start + (end - start) * Easing::apply(type, static_cast<float>(elapsedTime / duration)));
 }
@@ -17,7 +17,10 @@
 
 #include "TweenTypes.h"
 #include <string>
+#include <string_view>
 #include <map>
+#include <mutex>
+#include <vector>
 
 class ViewInfo;
 
@@ -31,37 +34,25 @@ public:
     static float animateSingle(TweenAlgorithm type, double start, double end, double duration, double elapsedTime);
     static TweenAlgorithm getTweenType(std::string name);
     static bool getTweenProperty(std::string name, TweenProperty &property);
+    // Playlist names are matched by id, 0 stands for no playlist
+    static int playlistId(std::string_view name);
+    bool appliesTo(int playlist) const;
     TweenProperty property;
     double duration;
     bool   startDefined{ true };
-    std::string playlistFilter;
+    std::vector<int> playlistFilter; // ids of the playlists the tween is limited to
 
-private:
-    static double easeInQuadratic(double elapsedTime, double duration, double b, double c);
-    static double easeOutQuadratic(double elapsedTime, double duration, double b, double c);
-    static double easeInOutQuadratic(double elapsedTime, double duration, double b, double c);
-    static double easeInCubic(double elapsedTime, double duration, double b, double c);
-    static double easeOutCubic(double elapsedTime, double duration, double b, double c);
-    static double easeInOutCubic(double elapsedTime, double duration, double b, double c);
-    static double easeInQuartic(double elapsedTime, double duration, double b, double c);
-    static double easeOutQuartic(double elapsedTime, double duration, double b, double c);
-    static double easeInOutQuartic(double elapsedTime, double duration, double b, double c);
-    static double easeInQuintic(double elapsedTime, double duration, double b, double c);
-    static double easeOutQuintic(double elapsedTime, double duration, double b, double c);
-    static double easeInOutQuintic(double elapsedTime, double duration, double b, double c);
-    static double easeInSine(double elapsedTime, double duration, double b, double c);
-    static double easeOutSine(double elapsedTime, double duration, double b, double c);
-    static double easeInOutSine(double elapsedTime, double duration, double b, double c);
-    static double easeInExponential(double elapsedTime, double duration, double b, double c);
-    static double easeOutExponential(double elapsedTime, double duration, double b, double c);
-    static double easeInOutExponential(double elapsedTime, double duration, double b, double c);
-    static double easeInCircular(double elapsedTime, double duration, double b, double c);
-    static double easeOutCircular(double elapsedTime, double duration, double b, double c);
-    static double easeInOutCircular(double elapsedTime, double duration, double b, double c);
-    static double linear(double elapsedTime, double duration, double b, double c);
+    // Turns the tween into another, without a playlist filter
+    void reset(TweenProperty newProperty, TweenAlgorithm newType, double newStart, double newEnd, double newDuration);
+    TweenAlgorithm getType() const { return type; }
+    double getStart() const { return start; }
+    double getEnd() const { return end; }
 
+private:
     static std::map<std::string, TweenAlgorithm, std::less<>> tweenTypeMap_;
     static std::map<std::string, TweenProperty, std::less<>> tweenPropertyMap_;
+    static std::map<std::string, int, std::less<>> playlistIds_;
+    static std::mutex playlistIdsMutex_;
     TweenAlgorithm type;
     double start;
     double end;
@@ -0,0 +1,359 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TweenEngine.h"
+#include "Easing.h"
+#include "Tween.h"
+#include "TweenSet.h"
+#include "../ViewInfo.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr int algorithmCount = EASE_INOUT_CIRCULAR + 1;
+    constexpr int propertyCount = TWEEN_PROPERTY_RESTART + 1;
+
+    template <typename V>
+    auto floatProperty(V& view, TweenProperty property) -> decltype(&view.X)
+    {
+        switch (property) {
+        case TWEEN_PROPERTY_HEIGHT:           return &view.Height;
+        case TWEEN_PROPERTY_WIDTH:            return &view.Width;
+        case TWEEN_PROPERTY_ANGLE:            return &view.Angle;
+        case TWEEN_PROPERTY_ALPHA:            return &view.Alpha;
+        case TWEEN_PROPERTY_X:                return &view.X;
+        case TWEEN_PROPERTY_Y:                return &view.Y;
+        case TWEEN_PROPERTY_X_ORIGIN:         return &view.XOrigin;
+        case TWEEN_PROPERTY_Y_ORIGIN:         return &view.YOrigin;
+        case TWEEN_PROPERTY_X_OFFSET:         return &view.XOffset;
+        case TWEEN_PROPERTY_Y_OFFSET:         return &view.YOffset;
+        case TWEEN_PROPERTY_FONT_SIZE:        return &view.FontSize;
+        case TWEEN_PROPERTY_BACKGROUND_ALPHA: return &view.BackgroundAlpha;
+        case TWEEN_PROPERTY_MAX_WIDTH:        return &view.MaxWidth;
+        case TWEEN_PROPERTY_MAX_HEIGHT:       return &view.MaxHeight;
+        case TWEEN_PROPERTY_CONTAINER_X:      return &view.ContainerX;
+        case TWEEN_PROPERTY_CONTAINER_Y:      return &view.ContainerY;
+        case TWEEN_PROPERTY_CONTAINER_WIDTH:  return &view.ContainerWidth;
+        case TWEEN_PROPERTY_CONTAINER_HEIGHT: return &view.ContainerHeight;
+        case TWEEN_PROPERTY_VOLUME:           return &view.Volume;
+        default:                              return nullptr;
+        }
+    }
+
+    double readProperty(const ViewInfo& view, TweenProperty property)
+    {
+        switch (property) {
+        case TWEEN_PROPERTY_LAYER:   return view.Layer;
+        case TWEEN_PROPERTY_MONITOR: return view.Monitor;
+        case TWEEN_PROPERTY_RESTART: return view.Restart;
+        default: {
+            const float* value = floatProperty(view, property);
+            return value ? *value : 0;
+        }
+        }
+    }
+
+    void writeProperty(ViewInfo& view, TweenProperty property, double value)
+    {
+        switch (property) {
+        case TWEEN_PROPERTY_LAYER:   view.Layer = static_cast<unsigned int>(value); break;
+        case TWEEN_PROPERTY_MONITOR: view.Monitor = static_cast<int>(value); break;
+        case TWEEN_PROPERTY_RESTART: view.Restart = value != 0; break;
+        default:
+            if (float* target = floatProperty(view, property)) {
+                *target = static_cast<float>(value);
+            }
+            break;
+        }
+    }
+
+    // No branches and no calls, the compiler is free to vectorize it
+    template <float (*Ease)(float)>
+    void ease(const float* start, const float* delta, const float* progress, float* value, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            value[i] = start[i] + delta[i] * Ease(progress[i]);
+        }
+    }
+
+    // Same for a sampled curve
+    void interpolate(const float* table, const float* start, const float* delta, const float* progress, float* value, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            value[i] = start[i] + delta[i] * Easing::lookup(table, progress[i]);
+        }
+    }
+}
+
+TweenEngine::TweenEngine()
+    : tracks_(algorithmCount)
+{
+}
+
+TweenEngine::Clock* TweenEngine::bind(const TweenSet& tweens, ViewInfo& target, const ViewInfo& from, int playlist)
+{
+    // A later tween of a property overrides an earlier one, but the set still
+    // lasts until the longest is done
+    const Tween* last[propertyCount] = {};
+    float duration = 0;
+    for (unsigned int i = 0; i < tweens.size(); ++i) {
+        const Tween* tween = tweens.getTween(i);
+        if (!tween || !tween->appliesTo(playlist)) {
+            continue;
+        }
+        duration = std::max(duration, static_cast<float>(tween->duration));
+        last[tween->property] = tween;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Clock* clock = newClock(duration);
+
+    for (int property = 0; property < propertyCount; ++property) {
+        const Tween* tween = last[property];
+        if (!tween || tween->property == TWEEN_PROPERTY_NOP) {
+            continue;
+        }
+
+        float* value = floatProperty(target, tween->property);
+        if (value) {
+            float start = tween->startDefined ? static_cast<float>(tween->getStart()) : *floatProperty(from, tween->property);
+            tracks_[tween->getType()].push(start, static_cast<float>(tween->getEnd()) - start,
+                static_cast<float>(tween->duration), clock, value);
+            continue;
+        }
+
+        double start = tween->getStart();
+        if (!tween->startDefined && tween->property == TWEEN_PROPERTY_LAYER) {
+            start = from.Layer;
+        }
+        else if (!tween->startDefined && tween->property == TWEEN_PROPERTY_MONITOR) {
+            start = from.Monitor;
+        }
+        discrete_.push_back({ tween->property, tween->getType(), start, tween->getEnd(), tween->duration, clock, &target });
+    }
+
+    return clock;
+}
+
+TweenEngine::Clock* TweenEngine::bind(std::shared_ptr<const Timeline> timeline, ViewInfo& target, const ViewInfo& from)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Clock* clock = newClock(static_cast<float>(timeline->duration()));
+    for (const Timeline::Channel& channel : timeline->channels()) {
+        timelines_.push_back({ timeline, &channel, readProperty(from, channel.property), -1, clock, &target });
+    }
+    return clock;
+}
+
+void TweenEngine::loop(Clock* clock)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (TimelineTrack& track : timelines_) {
+        if (track.clock == clock) {
+            track.from = readProperty(*track.target, track.channel->property);
+            track.last = -1;
+        }
+    }
+}
+
+// Called with the mutex held
+TweenEngine::Clock* TweenEngine::newClock(float duration)
+{
+    Clock* clock;
+    if (free_.empty()) {
+        clocks_.emplace_back();
+        clock = &clocks_.back();
+    }
+    else {
+        clock = free_.back();
+        free_.pop_back();
+    }
+    clock->elapsed = 0;
+    clock->duration = duration;
+    clock->ticked = false;
+    clock->bound = true;
+    return clock;
+}
+
+void TweenEngine::unbind(Clock* clock)
+{
+    if (!clock) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    clock->bound = false;
+    unbound_.push_back(clock);
+}
+
+void TweenEngine::update()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // The tracks of unbound sets may point into deleted components
+    if (!unbound_.empty()) {
+        for (Tracks& tracks : tracks_) {
+            tracks.removeUnbound();
+        }
+        discrete_.erase(std::remove_if(discrete_.begin(), discrete_.end(),
+            [](const DiscreteTrack& track) { return !track.clock->bound; }), discrete_.end());
+        timelines_.erase(std::remove_if(timelines_.begin(), timelines_.end(),
+            [](const TimelineTrack& track) { return !track.clock->bound; }), timelines_.end());
+        free_.insert(free_.end(), unbound_.begin(), unbound_.end());
+        unbound_.clear();
+    }
+
+    for (int type = 0; type < algorithmCount; ++type) {
+        tracks_[type].evaluate(static_cast<TweenAlgorithm>(type));
+    }
+
+    for (const DiscreteTrack& track : discrete_) {
+        if (!track.clock->ticked) {
+            continue;
+        }
+        double elapsed = std::min(static_cast<double>(track.clock->elapsed), track.duration);
+        switch (track.property) {
+        case TWEEN_PROPERTY_LAYER:
+            track.target->Layer = static_cast<unsigned int>(Tween::animateSingle(track.type, track.start, track.end, track.duration, elapsed));
+            break;
+        case TWEEN_PROPERTY_MONITOR:
+            track.target->Monitor = static_cast<int>(Tween::animateSingle(track.type, track.start, track.end, track.duration, elapsed));
+            break;
+        case TWEEN_PROPERTY_RESTART:
+            track.target->Restart = (track.duration != 0.0) && (elapsed == 0.0);
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (TimelineTrack& track : timelines_) {
+        if (!track.clock->ticked) {
+            continue;
+        }
+        double time = std::min(static_cast<double>(track.clock->elapsed), static_cast<double>(track.clock->duration));
+        if (const Timeline::Segment* segment = track.channel->segmentAt(time)) {
+            if (track.channel->property == TWEEN_PROPERTY_RESTART) {
+                track.target->Restart = segment->duration != 0 && track.last < segment->begin;
+            }
+            else {
+                writeProperty(*track.target, track.channel->property, track.channel->value(*segment, time, track.from));
+            }
+        }
+        track.last = time;
+    }
+
+    for (Clock& clock : clocks_) {
+        clock.ticked = false;
+    }
+}
+
+size_t TweenEngine::size()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = discrete_.size() + timelines_.size();
+    for (const Tracks& tracks : tracks_) {
+        count += tracks.target.size();
+    }
+    return count;
+}
+
+void TweenEngine::Tracks::push(float trackStart, float trackDelta, float trackDuration, Clock* trackClock, float* trackTarget)
+{
+    start.push_back(trackStart);
+    delta.push_back(trackDelta);
+    duration.push_back(trackDuration);
+    progress.push_back(0);
+    value.push_back(trackStart);
+    clock.push_back(trackClock);
+    target.push_back(trackTarget);
+}
+
+void TweenEngine::Tracks::removeUnbound()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < clock.size(); ++i) {
+        if (!clock[i]->bound) {
+            continue;
+        }
+        start[kept] = start[i];
+        delta[kept] = delta[i];
+        duration[kept] = duration[i];
+        clock[kept] = clock[i];
+        target[kept] = target[i];
+        ++kept;
+    }
+    start.resize(kept);
+    delta.resize(kept);
+    duration.resize(kept);
+    progress.resize(kept);
+    value.resize(kept);
+    clock.resize(kept);
+    target.resize(kept);
+}
+
+void TweenEngine::Tracks::evaluate(TweenAlgorithm type)
+{
+    size_t count = target.size();
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        float elapsed = std::min(clock[i]->elapsed, duration[i]);
+        progress[i] = duration[i] > 0 ? elapsed / duration[i] : 0;
+    }
+
+    const float* s = start.data();
+    const float* d = delta.data();
+    const float* p = progress.data();
+    float* v = value.data();
+    if (const float* table = Easing::table(type)) {
+        interpolate(table, s, d, p, v, count);
+    }
+    else {
+        switch (type) {
+        case EASE_IN_QUADRATIC:      ease<Easing::inQuadratic>(s, d, p, v, count); break;
+        case EASE_OUT_QUADRATIC:     ease<Easing::outQuadratic>(s, d, p, v, count); break;
+        case EASE_INOUT_QUADRATIC:   ease<Easing::inOutQuadratic>(s, d, p, v, count); break;
+        case EASE_IN_CUBIC:          ease<Easing::inCubic>(s, d, p, v, count); break;
+        case EASE_OUT_CUBIC:         ease<Easing::outCubic>(s, d, p, v, count); break;
+        case EASE_INOUT_CUBIC:       ease<Easing::inOutCubic>(s, d, p, v, count); break;
+        case EASE_IN_QUARTIC:        ease<Easing::inQuartic>(s, d, p, v, count); break;
+        case EASE_OUT_QUARTIC:       ease<Easing::outQuartic>(s, d, p, v, count); break;
+        case EASE_INOUT_QUARTIC:     ease<Easing::inOutQuartic>(s, d, p, v, count); break;
+        case EASE_IN_QUINTIC:        ease<Easing::inQuintic>(s, d, p, v, count); break;
+        case EASE_OUT_QUINTIC:       ease<Easing::outQuintic>(s, d, p, v, count); break;
+        case EASE_INOUT_QUINTIC:     ease<Easing::inOutQuintic>(s, d, p, v, count); break;
+        case EASE_IN_SINE:           ease<Easing::inSine>(s, d, p, v, count); break;
+        case EASE_OUT_SINE:          ease<Easing::outSine>(s, d, p, v, count); break;
+        case EASE_INOUT_SINE:        ease<Easing::inOutSine>(s, d, p, v, count); break;
+        case EASE_IN_EXPONENTIAL:    ease<Easing::inExponential>(s, d, p, v, count); break;
+        case EASE_OUT_EXPONENTIAL:   ease<Easing::outExponential>(s, d, p, v, count); break;
+        case EASE_INOUT_EXPONENTIAL: ease<Easing::inOutExponential>(s, d, p, v, count); break;
+        case EASE_IN_CIRCULAR:       ease<Easing::inCircular>(s, d, p, v, count); break;
+        case EASE_OUT_CIRCULAR:      ease<Easing::outCircular>(s, d, p, v, count); break;
+        case EASE_INOUT_CIRCULAR:    ease<Easing::inOutCircular>(s, d, p, v, count); break;
+        case LINEAR:
+        default:                     ease<Easing::linear>(s, d, p, v, count); break;
+        }
+    }
+
+    // A tween without a duration holds its start value
+    for (size_t i = 0; i < count; ++i) {
+        if (clock[i]->ticked) {
+            *target[i] = duration[i] > 0 ? v[i] : s[i];
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Timeline.h"
+#include "TweenTypes.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TweenSet;
+class ViewInfo;
+
+// Evaluates the tweens of every animating component of a page.
+//
+// A component binds the tween set it plays. The tweens that apply are copied
+// into flat arrays, one group per easing, and from then on the component only
+// reports its elapsed time. update() evaluates each group in one loop and
+// writes the results into the components' ViewInfo.
+class TweenEngine
+{
+public:
+    // Time line of a bound tween set, written by its component
+    struct Clock
+    {
+        float elapsed{ 0 };
+        float duration{ 0 }; // of the longest tween, the set is done after it
+        bool  ticked{ false };
+        bool  bound{ false };
+    };
+
+    TweenEngine();
+    // The tweens without a start value start from the values in from
+    Clock* bind(const TweenSet& tweens, ViewInfo& target, const ViewInfo& from, int playlist);
+    // Plays every set of an animation on one clock
+    Clock* bind(std::shared_ptr<const Timeline> timeline, ViewInfo& target, const ViewInfo& from);
+    // Plays a bound timeline again, starting from the values it ended with
+    void loop(Clock* clock);
+    void unbind(Clock* clock);
+    // The set is evaluated at this time on the next update
+    static void tick(Clock* clock, float elapsed)
+    {
+        clock->elapsed = elapsed;
+        clock->ticked = true;
+    }
+    // Evaluates the sets ticked since the last update
+    void update();
+    size_t size();
+
+private:
+    // Float properties, structure of arrays
+    struct Tracks
+    {
+        std::vector<float>  start;
+        std::vector<float>  delta;
+        std::vector<float>  duration;
+        std::vector<float>  progress;
+        std::vector<float>  value;
+        std::vector<Clock*> clock;
+        std::vector<float*> target;
+
+        void push(float trackStart, float trackDelta, float trackDuration, Clock* trackClock, float* trackTarget);
+        void removeUnbound();
+        void evaluate(TweenAlgorithm type);
+    };
+
+    // Layer, monitor and restart are not floats, there are only ever a few
+    struct DiscreteTrack
+    {
+        TweenProperty  property;
+        TweenAlgorithm type;
+        double         start;
+        double         end;
+        double         duration;
+        Clock*         clock;
+        ViewInfo*      target;
+    };
+
+    // A property of a bound timeline, there is one segment to evaluate at a time
+    struct TimelineTrack
+    {
+        std::shared_ptr<const Timeline> timeline;
+        const Timeline::Channel*        channel;
+        double                          from;
+        double                          last; // time of the previous evaluation, a restart fires once
+        Clock*                          clock;
+        ViewInfo*                       target;
+    };
+
+    Clock* newClock(float duration);
+
+    std::mutex                 mutex_;
+    std::vector<Tracks>        tracks_; // by TweenAlgorithm
+    std::vector<DiscreteTrack> discrete_;
+    std::vector<TimelineTrack> timelines_;
+    std::deque<Clock>          clocks_;
+    std::vector<Clock*>        unbound_; // reused once their tracks are removed
+    std::vector<Clock*>        free_;
+};
@@ -67,3 +67,47 @@ enum TweenProperty
     TWEEN_PROPERTY_NOP,
     TWEEN_PROPERTY_RESTART
 };
+
+// Events a layout animates with an on<Event> tag, the names are in AnimationEvents
+enum AnimationEvent
+{
+    ANIMATION_EVENT_NONE = -1,
+    ANIMATION_EVENT_ENTER,
+    ANIMATION_EVENT_EXIT,
+    ANIMATION_EVENT_IDLE,
+    ANIMATION_EVENT_MENU_IDLE,
+    ANIMATION_EVENT_MENU_SCROLL,
+    ANIMATION_EVENT_PLAYLIST_SCROLL,
+    ANIMATION_EVENT_HIGHLIGHT_ENTER,
+    ANIMATION_EVENT_HIGHLIGHT_EXIT,
+    ANIMATION_EVENT_MENU_ENTER,
+    ANIMATION_EVENT_MENU_EXIT,
+    ANIMATION_EVENT_GAME_ENTER,
+    ANIMATION_EVENT_GAME_EXIT,
+    ANIMATION_EVENT_PLAYLIST_ENTER,
+    ANIMATION_EVENT_PLAYLIST_EXIT,
+    ANIMATION_EVENT_PLAYLIST_NEXT_ENTER,
+    ANIMATION_EVENT_PLAYLIST_NEXT_EXIT,
+    ANIMATION_EVENT_PLAYLIST_PREV_ENTER,
+    ANIMATION_EVENT_PLAYLIST_PREV_EXIT,
+    ANIMATION_EVENT_MENU_JUMP_ENTER,
+    ANIMATION_EVENT_MENU_JUMP_EXIT,
+    ANIMATION_EVENT_ATTRACT_ENTER,
+    ANIMATION_EVENT_ATTRACT,
+    ANIMATION_EVENT_ATTRACT_EXIT,
+    ANIMATION_EVENT_JUKEBOX_JUMP,
+    ANIMATION_EVENT_GAME_INFO_ENTER,
+    ANIMATION_EVENT_GAME_INFO_EXIT,
+    ANIMATION_EVENT_COLLECTION_INFO_ENTER,
+    ANIMATION_EVENT_COLLECTION_INFO_EXIT,
+    ANIMATION_EVENT_BUILD_INFO_ENTER,
+    ANIMATION_EVENT_BUILD_INFO_EXIT,
+    ANIMATION_EVENT_MENU_ACTION_INPUT_ENTER,
+    ANIMATION_EVENT_MENU_ACTION_INPUT_EXIT,
+    ANIMATION_EVENT_MENU_ACTION_SELECT_ENTER,
+    ANIMATION_EVENT_MENU_ACTION_SELECT_EXIT,
+    ANIMATION_EVENT_COUNT
+};
+
+// Animations for menu indexes at or above this are for the active menu
+static const int MENU_INDEX_HIGH = 16;
@@ -19,6 +19,7 @@
 #include "../../Utility/Log.h"
 #include "../../SDL.h"
 #include "../PageBuilder.h"
+#include "../TextureRegistry.h"
 
 Component::Component(Page &p)
 : page(p)
@@ -28,8 +29,8 @@ Component::Component(Page &p)
     animationDoneRemove_      = false;
     id_                       = -1;
     backgroundTexture_ = nullptr;
-    animationRequestedType_ = "";
-    animationType_ = "";
+    animationRequestedType_ = ANIMATION_EVENT_NONE;
+    animationType_ = ANIMATION_EVENT_NONE;
     animationRequested_ = false;
     newItemSelected = false;
     newScrollItemSelected = false;
@@ -38,15 +39,21 @@ Component::Component(Page &p)
     currentTweenIndex_ = 0;
     currentTweenComplete_ = true;
     elapsedTweenTime_ = 0;
-
-
+    tweenClock_ = nullptr;
+    tweenSetDone_ = false;
+    tweenTimeline_ = false;
+    playlistId_ = 0;
+    tweenPlaylistId_ = 0;
 }
 
-Component::~Component() = default;
+Component::~Component()
+{
+    unbindTweenSet();
+}
 
 void Component::freeGraphicsMemory() {
-    animationRequestedType_ = "";
-    animationType_ = "";
+    animationRequestedType_ = ANIMATION_EVENT_NONE;
+    animationType_ = ANIMATION_EVENT_NONE;
     animationRequested_ = false;
     newItemSelected = false;
     newScrollItemSelected = false;
@@ -57,10 +64,12 @@ void Component::freeGraphicsMemory() {
     currentTweenIndex_ = 0;
     currentTweenComplete_ = true;
     elapsedTweenTime_ = 0;
+    tweenSetDone_ = false;
+    unbindTweenSet();
 
     if (backgroundTexture_) {
         SDL_LockMutex(SDL::getMutex());
-        SDL_DestroyTexture(backgroundTexture_);
+        TextureRegistry::destroy(backgroundTexture_);
         SDL_UnlockMutex(SDL::getMutex());
 
         backgroundTexture_ = nullptr;
@@ -76,10 +85,12 @@ void Component::allocateGraphicsMemory()
         SDL_Surface* surface = SDL_CreateRGBSurface(0, 4, 4, 32, 0, 0, 0, 0);
         SDL_FillRect(surface, nullptr, SDL_MapRGB(surface->format, 255, 255, 255));
 
-        backgroundTexture_ = SDL_CreateTextureFromSurface(SDL::getRenderer(baseViewInfo.Monitor), surface);
+        backgroundTexture_ = TextureRegistry::createFromSurface(SDL::getRenderer(baseViewInfo.Monitor),
+            TextureRegistry::OwnerImage, baseViewInfo.Monitor, surface);
 
         SDL_FreeSurface(surface);
         SDL_SetTextureBlendMode(backgroundTexture_, SDL_BLENDMODE_BLEND);
+        SDL::invalidate(backgroundTexture_);
     }
 }
 
@@ -93,11 +104,11 @@ void Component::initializeFonts()
 {
 }
 
-const std::string& Component::getAnimationRequestedType() const {
+AnimationEvent Component::getAnimationRequestedType() const {
     return animationRequestedType_;
 }
 
-void Component::triggerEvent(const std::string_view& event, int menuIndex)
+void Component::triggerEvent(AnimationEvent event, int menuIndex)
 {
     animationRequestedType_ = event;
     animationRequested_     = true;
@@ -107,6 +118,12 @@ void Component::triggerEvent(const std::string_view& event, int menuIndex)
 void Component::setPlaylist(const std::string_view& name)
 {
     this->playlistName = name;
+    playlistId_ = Tween::playlistId(name);
+}
+
+int Component::getPlaylistId() const
+{
+    return playlistId_;
 }
 
 void Component::setNewItemSelected()
@@ -126,22 +143,22 @@ void Component::setId( int id )
 
 bool Component::isIdle() const
 {
-    return (currentTweenComplete_ || animationType_ == "idle" || animationType_ == "menuIdle" || animationType_ == "attract");
+    return (currentTweenComplete_ || animationType_ == ANIMATION_EVENT_IDLE || animationType_ == ANIMATION_EVENT_MENU_IDLE || animationType_ == ANIMATION_EVENT_ATTRACT);
 }
 
 bool Component::isAttractIdle() const
 {
-    return (currentTweenComplete_ || animationType_ == "idle" || animationType_ == "menuIdle");
+    return (currentTweenComplete_ || animationType_ == ANIMATION_EVENT_IDLE || animationType_ == ANIMATION_EVENT_MENU_IDLE);
 }
 
 bool Component::isMenuScrolling() const
 {
-    return (!currentTweenComplete_ && (animationType_ == "menuScroll" || animationType_ == "playlistScroll"));
+    return (!currentTweenComplete_ && (animationType_ == ANIMATION_EVENT_MENU_SCROLL || animationType_ == ANIMATION_EVENT_PLAYLIST_SCROLL));
 }
 
 bool Component::isPlaylistScrolling() const
 {
-    return (!currentTweenComplete_ && animationType_ == "playlistScroll");
+    return (!currentTweenComplete_ && animationType_ == ANIMATION_EVENT_PLAYLIST_SCROLL);
 }
 
 void Component::setTweens(std::shared_ptr<AnimationEvents> set) {
@@ -155,7 +172,34 @@ std::string_view Component::filePath()
 
 bool Component::update(float dt) {
     elapsedTweenTime_ += dt;
-    if (animationRequested_ && animationRequestedType_ != "" && !tweens_->getAnimationMap().empty()) {
+
+    // The page's tween engine wrote the end of the finished set last frame,
+    // the next set starts from there
+    if (tweenSetDone_) {
+        tweenSetDone_ = false;
+        storeViewInfo_ = baseViewInfo;
+        if (tweenTimeline_ && !animationRequested_ && animationType_ == ANIMATION_EVENT_IDLE &&
+            tweens_ && idleAnimation() == currentTweens_.lock()) {
+            // An idle timeline loops in place and keeps the time it ran over
+            elapsedTweenTime_ -= tweenClock_->duration;
+            page.getTweenEngine().loop(tweenClock_);
+            currentTweenComplete_ = false;
+        }
+        else {
+            elapsedTweenTime_ = dt;
+            if (currentTweenComplete_) {
+                currentTweens_.reset();
+                currentTweenIndex_ = 0;
+                unbindTweenSet();
+            }
+            else {
+                currentTweenIndex_++;
+                bindTweenSet();
+            }
+        }
+    }
+
+    if (animationRequested_ && animationRequestedType_ != ANIMATION_EVENT_NONE && tweens_) {
         std::shared_ptr<Animation> newTweens = nullptr;
         if (menuIndex_ >= MENU_INDEX_HIGH) {
             newTweens = tweens_->getAnimation(animationRequestedType_, MENU_INDEX_HIGH);
@@ -178,34 +222,39 @@ bool Component::update(float dt) {
             elapsedTweenTime_ = 0;
             storeViewInfo_ = baseViewInfo;
             currentTweenComplete_ = false;
+            bindTweenSet();
         }
         animationRequested_ = false;
     }
 
     if (tweens_ && currentTweenComplete_) {
-        animationType_ = "idle";
-        auto idleTweens = tweens_->getAnimation("idle", menuIndex_);
-        if (idleTweens && idleTweens->size() == 0 && !page.isMenuScrolling()) {
-            idleTweens = tweens_->getAnimation("menuIdle", menuIndex_);
-        }
-        currentTweens_ = idleTweens;  // Assign to weak_ptr
+        animationType_ = ANIMATION_EVENT_IDLE;
+        currentTweens_ = idleAnimation();  // Assign to weak_ptr
         currentTweenIndex_ = 0;
         elapsedTweenTime_ = 0;
         storeViewInfo_ = baseViewInfo;
         currentTweenComplete_ = false;
         animationRequested_ = false;
+        bindTweenSet();
     }
 
     // Lock weak_ptr before using
     std::shared_ptr<Animation> lockedTweens = currentTweens_.lock();
-    if (lockedTweens) {
-        currentTweenComplete_ = animate();
-        if (currentTweenComplete_) {
-            currentTweens_.reset();
-            currentTweenIndex_ = 0;
+    if (lockedTweens && tweenClock_ && currentTweenIndex_ < lockedTweens->size()) {
+        // Playlist filters were applied when the set was bound
+        if (playlistId_ != tweenPlaylistId_) {
+            bindTweenSet();
+        }
+        TweenEngine::tick(tweenClock_, elapsedTweenTime_);
+        if (elapsedTweenTime_ >= tweenClock_->duration) {
+            tweenSetDone_ = true;
+            currentTweenComplete_ = tweenTimeline_ || currentTweenIndex_ + 1 >= lockedTweens->size();
         }
     }
     else {
+        currentTweens_.reset();
+        currentTweenIndex_ = 0;
+        unbindTweenSet();
         currentTweenComplete_ = true;
     }
 
@@ -213,6 +262,23 @@ bool Component::update(float dt) {
 }
 
 // used to draw lines in the layout using <container>
+bool Component::isCulled() const
+{
+    if (baseViewInfo.Alpha <= 0.0f || baseViewInfo.Monitor >= SDL::getScreenCount())
+        return true;
+
+    // Reflections are drawn next to the view rectangle
+    if (!drawsWithinView() || !baseViewInfo.style().Reflection.empty())
+        return false;
+
+    SDL_FRect rect = {
+        baseViewInfo.XRelativeToOrigin(), baseViewInfo.YRelativeToOrigin(),
+        baseViewInfo.ScaledWidth(), baseViewInfo.ScaledHeight() };
+    return SDL::isOutside(baseViewInfo, rect,
+        page.getLayoutWidthByMonitor(baseViewInfo.Monitor),
+        page.getLayoutHeightByMonitor(baseViewInfo.Monitor));
+}
+
 void Component::draw()
 {
     if (backgroundTexture_ && baseViewInfo.Alpha > 0.0f) {
@@ -224,218 +290,52 @@ void Component::draw()
 
 
         SDL_SetTextureColorMod(backgroundTexture_,
-            static_cast<char>(baseViewInfo.BackgroundRed * 255),
-            static_cast<char>(baseViewInfo.BackgroundGreen * 255),
-            static_cast<char>(baseViewInfo.BackgroundBlue * 255));
+            static_cast<char>(baseViewInfo.style().BackgroundRed * 255),
+            static_cast<char>(baseViewInfo.style().BackgroundGreen * 255),
+            static_cast<char>(baseViewInfo.style().BackgroundBlue * 255));
 
         SDL::renderCopyF(backgroundTexture_, baseViewInfo.BackgroundAlpha, nullptr, &rect, baseViewInfo, page.getLayoutWidthByMonitor(baseViewInfo.Monitor), page.getLayoutHeightByMonitor(baseViewInfo.Monitor));
     }
 }
 
-bool Component::animate() {
-    bool completeDone = false;
-    auto sharedTweens = currentTweens_.lock(); // Lock the weak_ptr to get a shared_ptr
+void Component::bindTweenSet()
+{
+    unbindTweenSet();
+
+    std::shared_ptr<Animation> lockedTweens = currentTweens_.lock();
+    if (!lockedTweens || currentTweenIndex_ >= lockedTweens->size())
+        return;
 
-    if (!sharedTweens || currentTweenIndex_ >= sharedTweens->size()) {
-        completeDone = true;
+    // Animations of several sets play as one timeline
+    tweenTimeline_ = lockedTweens->size() > 1;
+    if (tweenTimeline_) {
+        tweenClock_ = page.getTweenEngine().bind(lockedTweens->timeline(playlistId_), baseViewInfo, storeViewInfo_);
     }
     else {
-        bool currentDone = true;
-        auto tweens = sharedTweens->tweenSet(currentTweenIndex_);
-        if (!tweens) return true; // Additional check for safety
-
-        std::string playlist;
-        bool foundFiltered;
-
-        for (unsigned int i = 0; i < tweens->size(); i++) {
-            const Tween* tween = tweens->getTween(i); // Ensure const correctness
-
-            if (!tween->playlistFilter.empty() && !playlistName.empty()) {
-                foundFiltered = false;
-                std::stringstream ss(tween->playlistFilter);
-                while (getline(ss, playlist, ',')) {
-                    if (playlistName == playlist) {
-                        foundFiltered = true;
-                        break;
-                    }
-                }
-                if (!foundFiltered) continue;
-            }
-
-            double elapsedTime = elapsedTweenTime_;
-            if (elapsedTime < tween->duration)
-                currentDone = false;
-            else
-                elapsedTime = tween->duration;
-
-            switch (tween->property) {
-            case TWEEN_PROPERTY_X:
-                if (tween->startDefined)
-                    baseViewInfo.X = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.X = tween->animate(elapsedTime, storeViewInfo_.X);
-                break;
-
-            case TWEEN_PROPERTY_Y:
-                if (tween->startDefined)
-                    baseViewInfo.Y = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Y = tween->animate(elapsedTime, storeViewInfo_.Y);
-                break;
-
-            case TWEEN_PROPERTY_HEIGHT:
-                if (tween->startDefined)
-                    baseViewInfo.Height = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Height = tween->animate(elapsedTime, storeViewInfo_.Height);
-                break;
-
-            case TWEEN_PROPERTY_WIDTH:
-                if (tween->startDefined)
-                    baseViewInfo.Width = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Width = tween->animate(elapsedTime, storeViewInfo_.Width);
-                break;
-
-            case TWEEN_PROPERTY_ANGLE:
-                if (tween->startDefined)
-                    baseViewInfo.Angle = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Angle = tween->animate(elapsedTime, storeViewInfo_.Angle);
-                break;
-
-            case TWEEN_PROPERTY_ALPHA:
-                if (tween->startDefined)
-                    baseViewInfo.Alpha = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Alpha = tween->animate(elapsedTime, storeViewInfo_.Alpha);
-                break;
-
-            case TWEEN_PROPERTY_X_ORIGIN:
-                if (tween->startDefined)
-                    baseViewInfo.XOrigin = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.XOrigin = tween->animate(elapsedTime, storeViewInfo_.XOrigin);
-                break;
-
-            case TWEEN_PROPERTY_Y_ORIGIN:
-                if (tween->startDefined)
-                    baseViewInfo.YOrigin = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.YOrigin = tween->animate(elapsedTime, storeViewInfo_.YOrigin);
-                break;
-
-            case TWEEN_PROPERTY_X_OFFSET:
-                if (tween->startDefined)
-                    baseViewInfo.XOffset = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.XOffset = tween->animate(elapsedTime, storeViewInfo_.XOffset);
-                break;
-
-            case TWEEN_PROPERTY_Y_OFFSET:
-                if (tween->startDefined)
-                    baseViewInfo.YOffset = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.YOffset = tween->animate(elapsedTime, storeViewInfo_.YOffset);
-                break;
-
-            case TWEEN_PROPERTY_FONT_SIZE:
-                if (tween->startDefined)
-                    baseViewInfo.FontSize = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.FontSize = tween->animate(elapsedTime, storeViewInfo_.FontSize);
-                break;
-
-            case TWEEN_PROPERTY_BACKGROUND_ALPHA:
-                if (tween->startDefined)
-                    baseViewInfo.BackgroundAlpha = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.BackgroundAlpha = tween->animate(elapsedTime, storeViewInfo_.BackgroundAlpha);
-                break;
-
-            case TWEEN_PROPERTY_MAX_WIDTH:
-                if (tween->startDefined)
-                    baseViewInfo.MaxWidth = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.MaxWidth = tween->animate(elapsedTime, storeViewInfo_.MaxWidth);
-                break;
-
-            case TWEEN_PROPERTY_MAX_HEIGHT:
-                if (tween->startDefined)
-                    baseViewInfo.MaxHeight = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.MaxHeight = tween->animate(elapsedTime, storeViewInfo_.MaxHeight);
-                break;
-
-            case TWEEN_PROPERTY_LAYER:
-                if (tween->startDefined)
-                    baseViewInfo.Layer = static_cast<unsigned int>(tween->animate(elapsedTime));
-                else
-                    baseViewInfo.Layer = static_cast<unsigned int>(tween->animate(elapsedTime, storeViewInfo_.Layer));
-                break;
-
-            case TWEEN_PROPERTY_CONTAINER_X:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerX = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerX = tween->animate(elapsedTime, storeViewInfo_.ContainerX);
-                break;
-
-            case TWEEN_PROPERTY_CONTAINER_Y:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerY = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerY = tween->animate(elapsedTime, storeViewInfo_.ContainerY);
-                break;
-
-            case TWEEN_PROPERTY_CONTAINER_WIDTH:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerWidth = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerWidth = tween->animate(elapsedTime, storeViewInfo_.ContainerWidth);
-                break;
-
-            case TWEEN_PROPERTY_CONTAINER_HEIGHT:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerHeight = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerHeight = tween->animate(elapsedTime, storeViewInfo_.ContainerHeight);
-                break;
-
-            case TWEEN_PROPERTY_VOLUME:
-                if (tween->startDefined)
-                    baseViewInfo.Volume = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Volume = tween->animate(elapsedTime, storeViewInfo_.Volume);
-                break;
-
-            case TWEEN_PROPERTY_MONITOR:
-                if (tween->startDefined)
-                    baseViewInfo.Monitor = static_cast<unsigned int>(tween->animate(elapsedTime));
-                else
-                    baseViewInfo.Monitor = static_cast<unsigned int>(tween->animate(elapsedTime, storeViewInfo_.Monitor));
-                break;
-
-            case TWEEN_PROPERTY_NOP:
-                break;
-            case TWEEN_PROPERTY_RESTART:
-                baseViewInfo.Restart = (tween->duration != 0.0) && (elapsedTime == 0.0);
-                break;
-            }
-        }
-
-        if (currentDone) {
-            currentTweenIndex_++;
-            elapsedTweenTime_ = 0;
-            storeViewInfo_ = baseViewInfo;
-        }
+        auto tweens = lockedTweens->tweenSet(currentTweenIndex_);
+        if (!tweens)
+            return;
+        tweenClock_ = page.getTweenEngine().bind(*tweens, baseViewInfo, storeViewInfo_, playlistId_);
     }
+    tweenPlaylistId_ = playlistId_;
+}
 
-    if (!sharedTweens || currentTweenIndex_ >= sharedTweens->size()) {
-        completeDone = true;
+void Component::unbindTweenSet()
+{
+    if (tweenClock_) {
+        page.getTweenEngine().unbind(tweenClock_);
+        tweenClock_ = nullptr;
     }
+    tweenTimeline_ = false;
+}
 
-    return completeDone;
+std::shared_ptr<Animation> Component::idleAnimation()
+{
+    auto idleTweens = tweens_->getAnimation(ANIMATION_EVENT_IDLE, menuIndex_);
+    if (idleTweens && idleTweens->size() == 0 && !page.isMenuScrolling()) {
+        idleTweens = tweens_->getAnimation(ANIMATION_EVENT_MENU_IDLE, menuIndex_);
+    }
+    return idleTweens;
 }
 
 
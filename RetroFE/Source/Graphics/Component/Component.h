@@ -22,6 +22,7 @@
 #include "../ViewInfo.h"
 #include "../Animate/Tween.h"
 #include "../Animate/AnimationEvents.h"
+#include "../Animate/TweenEngine.h"
 #include "../../Collection/Item.h"
 #include <memory>
 
@@ -34,9 +35,10 @@ public:
     virtual void allocateGraphicsMemory();
     virtual void deInitializeFonts();
     virtual void initializeFonts();
-    const std::string& getAnimationRequestedType() const;
-    void triggerEvent(const std::string_view& event, int menuIndex = -1);
+    AnimationEvent getAnimationRequestedType() const;
+    void triggerEvent(AnimationEvent event, int menuIndex = -1);
     void setPlaylist(const std::string_view& name );
+    int getPlaylistId() const;
     void setNewItemSelected();
     void setNewScrollItemSelected();
     bool isIdle() const;
@@ -48,8 +50,20 @@ public:
     void setId( int id );
 
     virtual std::string_view filePath();
+    // Advances the animation clock. The tween values for this frame are written
+    // by the page's engine after every component has updated, so baseViewInfo
+    // holds the previous frame's values throughout update(). Subclasses read
+    // them before calling Component::update, where they were also last frame's.
     virtual bool update(float dt);
     virtual void draw();
+    // True when draw() would show nothing this frame
+    bool isCulled() const;
+    // Components that never draw outside their view rectangle can also be
+    // culled when that rectangle is off screen
+    virtual bool drawsWithinView() const { return false; }
+    // Components whose update reaches into the page, videos, fonts or
+    // textures are not updated in parallel with others
+    virtual bool updatesSerially() const { return false; }
     void setTweens(std::shared_ptr<AnimationEvents> set);
     virtual bool isPlaying();
     virtual bool isJukeboxPlaying();
@@ -81,7 +95,9 @@ protected:
 
 private:
 
-    bool animate();
+    void bindTweenSet();
+    void unbindTweenSet();
+    std::shared_ptr<Animation> idleAnimation();
 
     std::shared_ptr<AnimationEvents> tweens_; // Use shared_ptr for tweens_
     std::weak_ptr<Animation> currentTweens_; // Use shared_ptr instead of raw pointer
@@ -91,8 +107,13 @@ private:
     unsigned int currentTweenIndex_;
     bool         currentTweenComplete_;
     float        elapsedTweenTime_;
-    std::string  animationRequestedType_;
-    std::string  animationType_;
+    TweenEngine::Clock* tweenClock_;
+    int          playlistId_;
+    int          tweenPlaylistId_;
+    bool         tweenSetDone_;
+    bool         tweenTimeline_; // the whole animation is bound, not one of its sets
+    AnimationEvent animationRequestedType_;
+    AnimationEvent animationType_;
     bool         animationRequested_;
     bool         menuScrollReload_;
     bool         animationDoneRemove_;
@@ -15,6 +15,7 @@
  */
 
 #include "Image.h"
+#include "../TextureRegistry.h"
 #include "../ViewInfo.h"
 #include "../../SDL.h"           // Ensure this header declares SDL::getRenderer and SDL::getMutex
 #include "../../Utility/Log.h"
@@ -39,6 +40,7 @@
 #include <webp/demux.h>
 #endif
 
+#include <algorithm>
 #include <string_view>
 #include <fstream>
 #include <vector>
@@ -75,7 +77,7 @@ Image::Image(const std::string& file, const std::string& altFile, Page& p, int m
     : Component(p), file_(file), altFile_(altFile), useTextureCaching_(useTextureCaching)
 {
     baseViewInfo.Monitor = monitor;
-    baseViewInfo.Additive = additive;
+    baseViewInfo.resetStyle(additive);
     baseViewInfo.Layout = page.getCurrentLayout();
 }
 
@@ -143,7 +145,11 @@ void Image::allocateGraphicsMemory() {
                 isUsingCachedSurfaces_ = true;
             }
             std::unique_lock<std::shared_mutex> lock(textureCacheMutex_);
-            textureCache_[cacheKey] = std::move(newCachedImage);
+            CachedImage& entry = textureCache_[cacheKey];
+            newCachedImage.users = entry.users + 1;
+            entry = std::move(newCachedImage);
+            holdsCacheEntry_ = true;
+            cacheKey_ = cacheKey;
         }
         return success;
         };
@@ -158,12 +164,23 @@ void Image::allocateGraphicsMemory() {
 void Image::freeGraphicsMemory() {
     Component::freeGraphicsMemory();
 
+    // Once no instance holds a cached image it may be evicted
+    if (holdsCacheEntry_) {
+        std::unique_lock<std::shared_mutex> lock(textureCacheMutex_);
+        auto it = textureCache_.find(cacheKey_);
+        if (it != textureCache_.end()) {
+            it->second.users--;
+            it->second.lastUsed = SDL_GetTicks();
+        }
+        holdsCacheEntry_ = false;
+    }
+
     // For static images.
     if (frameDelay_ == 0) {
         if (!useTextureCaching_) {
             // When caching is disabled, destroy the texture.
             if (texture_) {
-                SDL_DestroyTexture(texture_);
+                TextureRegistry::destroy(texture_);
             }
         }
         // Always reset the instance pointer.
@@ -174,7 +191,7 @@ void Image::freeGraphicsMemory() {
         if (!useTextureCaching_) {
             // When caching is disabled, destroy the animated texture.
             if (animatedTexture_) {
-                SDL_DestroyTexture(animatedTexture_);
+                TextureRegistry::destroy(animatedTexture_);
             }
         }
         // Always reset the instance pointer.
@@ -215,6 +232,7 @@ void Image::draw() {
             size_t framesToAdvance = elapsed / frameDelay_;
             currentFrame_ = (currentFrame_ + framesToAdvance) % animatedSurfaces_.size();
             lastFrameTime_ = currentTime - (elapsed % frameDelay_);
+            SDL::invalidate(animatedTexture_);
         }
         SDL_Surface* currentSurface = animatedSurfaces_[currentFrame_];
         if (!currentSurface) {
@@ -251,9 +269,13 @@ void Image::cleanupTextureCache() {
     std::unique_lock<std::shared_mutex> lock(textureCacheMutex_);
     for (auto& pair : textureCache_) {
         if (pair.second.texture) {
-            SDL_DestroyTexture(pair.second.texture);
+            TextureRegistry::destroy(pair.second.texture);
             pair.second.texture = nullptr;
         }
+        if (pair.second.animatedTexture) {
+            TextureRegistry::destroy(pair.second.animatedTexture);
+            pair.second.animatedTexture = nullptr;
+        }
         if (!pair.second.animatedSurfaces.empty()) {
             for (SDL_Surface* surf : pair.second.animatedSurfaces) {
                 if (surf) SDL_FreeSurface(surf);
@@ -267,14 +289,51 @@ void Image::cleanupTextureCache() {
     LOG_INFO("TextureCache", "All cached textures and animated surfaces have been destroyed.");
 }
 
+uint64_t Image::evictTextureCache(uint64_t bytes) {
+    SDL_LockMutex(SDL::getMutex());
+    std::unique_lock<std::shared_mutex> lock(textureCacheMutex_);
+
+    std::vector<std::pair<Uint32, PathCache::CacheKey>> unused;
+    for (const auto& [key, cachedImage] : textureCache_) {
+        if (cachedImage.users <= 0) {
+            unused.emplace_back(cachedImage.lastUsed, key);
+        }
+    }
+    std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    uint64_t freed = 0;
+    size_t evicted = 0;
+    for (const auto& [lastUsed, key] : unused) {
+        if (freed >= bytes) {
+            break;
+        }
+        auto it = textureCache_.find(key);
+        CachedImage& cachedImage = it->second;
+        freed += TextureRegistry::destroy(cachedImage.texture);
+        freed += TextureRegistry::destroy(cachedImage.animatedTexture);
+        for (SDL_Surface* surf : cachedImage.animatedSurfaces) {
+            if (surf) SDL_FreeSurface(surf);
+        }
+        textureCache_.erase(it);
+        ++evicted;
+    }
+
+    lock.unlock();
+    SDL_UnlockMutex(SDL::getMutex());
+    if (evicted > 0) {
+        LOG_INFO("TextureCache", "Evicted " + std::to_string(evicted) + " cached images not on screen");
+    }
+    return freed;
+}
+
 bool Image::loadFromCache(const LoadContext& ctx) {
     if (!ctx.useCache) {
         LOG_INFO("Image", "Caching is disabled. Skipping cache load for: " + ctx.filePath);
         return false;
     }
 
-    // Use a shared lock for reading.
-    std::shared_lock<std::shared_mutex> lock(textureCacheMutex_);
+    // Taking the entry counts as a use, so this needs the unique lock.
+    std::unique_lock<std::shared_mutex> lock(textureCacheMutex_);
     LOG_INFO("Image", "Attempting to locate cache entry for key associated with: " + ctx.filePath);
 
     auto it = textureCache_.find(ctx.cacheKey);
@@ -345,12 +404,13 @@ bool Image::loadFromCache(const LoadContext& ctx) {
 
     // If the cache entry is invalid, remove it.
     if (!validCacheEntry) {
-        lock.unlock();  // Release shared lock before acquiring unique lock.
-        std::unique_lock<std::shared_mutex> uniqueLock(textureCacheMutex_);
-        textureCache_.erase(ctx.cacheKey);
+        textureCache_.erase(it);
         LOG_WARNING("Image", "Removed invalid cache entry for: " + ctx.filePath);
         return false;
     }
+    cachedImage.users++;
+    holdsCacheEntry_ = true;
+    cacheKey_ = ctx.cacheKey;
     return true;
 }
 
@@ -421,13 +481,21 @@ bool Image::loadStaticImage(const std::vector<uint8_t>& buffer, LoadContext& ctx
         LOG_ERROR("Image", "Failed to create RWops from buffer: " + std::string(SDL_GetError()));
         return false;
     }
-    SDL_Texture* newTex = IMG_LoadTexture_RW(SDL::getRenderer(baseViewInfo.Monitor), rw, 0);
+    SDL_Surface* surface = IMG_Load_RW(rw, 0);
     SDL_RWclose(rw);
-    if (!newTex) {
+    if (!surface) {
         LOG_ERROR("Image", "Failed to load static texture: " + std::string(IMG_GetError()));
         return false;
     }
-    SDL_SetTextureBlendMode(newTex, baseViewInfo.Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+    SDL_Texture* newTex = TextureRegistry::createFromSurface(SDL::getRenderer(baseViewInfo.Monitor),
+        TextureRegistry::OwnerImage, baseViewInfo.Monitor, surface);
+    SDL_FreeSurface(surface);
+    if (!newTex) {
+        LOG_ERROR("Image", "Failed to load static texture: " + std::string(SDL_GetError()));
+        return false;
+    }
+    SDL::invalidate(newTex);
+    SDL_SetTextureBlendMode(newTex, baseViewInfo.style().Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
     int width, height;
     if (SDL_QueryTexture(newTex, nullptr, nullptr, &width, &height) == 0) {
         ctx.baseViewInfo.ImageWidth = static_cast<float>(width);
@@ -442,7 +510,7 @@ bool Image::loadStaticImage(const std::vector<uint8_t>& buffer, LoadContext& ctx
         LOG_INFO("Image", "Loaded static texture: " + ctx.filePath);
         return true;
     }
-    SDL_DestroyTexture(newTex);
+    TextureRegistry::destroy(newTex);
     return false;
 }
 
@@ -498,12 +566,13 @@ bool Image::loadAnimatedGIF(const std::vector<uint8_t>& buffer, LoadContext& ctx
         // Create the animated texture from the first frame, regardless of caching.
         if (!decodedSurfaces.empty()) {
             SDL_Surface* firstSurface = decodedSurfaces[0];
-            SDL_Texture* animTex = SDL_CreateTexture(SDL::getRenderer(baseViewInfo.Monitor),
+            SDL_Texture* animTex = TextureRegistry::create(SDL::getRenderer(baseViewInfo.Monitor), TextureRegistry::OwnerImage, baseViewInfo.Monitor,
                 firstSurface->format->format,
                 SDL_TEXTUREACCESS_STREAMING,
                 firstSurface->w, firstSurface->h);
             if (animTex) {
-                SDL_SetTextureBlendMode(animTex, baseViewInfo.Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+                SDL_SetTextureBlendMode(animTex, baseViewInfo.style().Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+                SDL::invalidate(animTex);
                 // Always update the instance's animatedTexture_
                 animatedTexture_ = animTex;
                 // If caching is enabled, update the cache entry as well.
@@ -594,12 +663,13 @@ bool Image::loadAnimatedWebP(const std::vector<uint8_t>& buffer, LoadContext& ct
         animatedSurfaces_ = decodedSurfaces; // Also update the instance's member.
         // Create the animated texture from the first frame.
         SDL_Surface* firstSurface = decodedSurfaces[0];
-        SDL_Texture* animTex = SDL_CreateTexture(SDL::getRenderer(baseViewInfo.Monitor),
+        SDL_Texture* animTex = TextureRegistry::create(SDL::getRenderer(baseViewInfo.Monitor), TextureRegistry::OwnerImage, baseViewInfo.Monitor,
             firstSurface->format->format,
             SDL_TEXTUREACCESS_STREAMING,
             firstSurface->w, firstSurface->h);
         if (animTex) {
-            SDL_SetTextureBlendMode(animTex, baseViewInfo.Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+            SDL_SetTextureBlendMode(animTex, baseViewInfo.style().Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+            SDL::invalidate(animTex);
             ctx.newCachedImage.animatedTexture = animTex;
             animatedTexture_ = animTex;
             }
@@ -613,12 +683,13 @@ bool Image::loadAnimatedWebP(const std::vector<uint8_t>& buffer, LoadContext& ct
         LOG_INFO("Image", "Decoded animated WebP into " + std::to_string(animatedSurfaces_.size()) + " surfaces");
         // Create the animated texture for immediate drawing.
         SDL_Surface* firstSurface = decodedSurfaces[0];
-        SDL_Texture* animTex = SDL_CreateTexture(SDL::getRenderer(baseViewInfo.Monitor),
+        SDL_Texture* animTex = TextureRegistry::create(SDL::getRenderer(baseViewInfo.Monitor), TextureRegistry::OwnerImage, baseViewInfo.Monitor,
             firstSurface->format->format,
             SDL_TEXTUREACCESS_STREAMING,
             firstSurface->w, firstSurface->h);
         if (animTex) {
-            SDL_SetTextureBlendMode(animTex, baseViewInfo.Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+            SDL_SetTextureBlendMode(animTex, baseViewInfo.style().Additive ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_BLEND);
+            SDL::invalidate(animTex);
             animatedTexture_ = animTex;
             }
         else {
@@ -56,10 +56,13 @@ public:
     void allocateGraphicsMemory() override;
     void freeGraphicsMemory() override;
     void draw() override;
+    bool drawsWithinView() const override { return true; }
     std::string_view filePath() override;
 
     // Static Cache Management
     static void cleanupTextureCache();
+    // Drops cached images no instance holds, least recently used first
+    static uint64_t evictTextureCache(uint64_t bytes);
 
 private:
     //-------------------------------------------------------------------------
@@ -100,6 +103,8 @@ private:
         SDL_Texture* animatedTexture = nullptr;     // For animated images.
         int frameDelay = 0;
         std::vector<SDL_Surface*> animatedSurfaces;
+        int users = 0;          // instances holding the entry
+        Uint32 lastUsed = 0;
     };
 
     //-------------------------------------------------------------------------
@@ -154,6 +159,8 @@ private:
     bool textureIsUncached_ = false;
     bool useTextureCaching_ = false;
     bool isUsingCachedSurfaces_ = false;
+    bool holdsCacheEntry_ = false;
+    PathCache::CacheKey cacheKey_{};
 
     // Static cache storage
     static PathCache pathCache_;
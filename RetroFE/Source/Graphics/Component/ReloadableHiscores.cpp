@@ -23,6 +23,7 @@
 #include "../../Utility/Utils.h"
 #include "../../SDL.h"
 #include "../Font.h"
+#include "../TextureRegistry.h"
 #include <fstream>
 #include <sstream>
 #include <vector>
@@ -218,7 +219,7 @@ void ReloadableHiscores::freeGraphicsMemory()
 {
 	Component::freeGraphicsMemory();
 	if (intermediateTexture_) {
-		SDL_DestroyTexture(intermediateTexture_);
+		TextureRegistry::destroy(intermediateTexture_);
 		intermediateTexture_ = nullptr;
 	}
 }
@@ -304,12 +305,8 @@ void ReloadableHiscores::draw() {
 		? baseViewInfo.Width : baseViewInfo.MaxWidth;
 	float imageMaxHeight = (baseViewInfo.Height < baseViewInfo.MaxHeight && baseViewInfo.Height > 0)
 		? baseViewInfo.Height : baseViewInfo.MaxHeight;
-	// Step 1: Save the current render target
+	// Step 1: Save the current render target, null when drawing straight to the window
 	SDL_Texture* originalTarget = SDL_GetRenderTarget(renderer);
-	if (!originalTarget) {
-		LOG_ERROR("ReloadableHiscores", "Unable to get current render target.");
-		return;
-	}
 
 	// Step 2: Create intermediate texture
 	if (!intermediateTexture_) {
@@ -479,6 +476,7 @@ void ReloadableHiscores::draw() {
 
 		SDL_RenderSetClipRect(renderer, nullptr);
 		SDL_SetRenderTarget(renderer, originalTarget);
+		SDL::invalidate(intermediateTexture_);
 	}
 
 	// Step 6: Define the destination rectangle where the intermediate texture should be drawn
@@ -580,12 +578,13 @@ void ReloadableHiscores::updateVisibleColumns(const HighScoreTable& table) {
 bool ReloadableHiscores::createIntermediateTexture(SDL_Renderer* renderer, int width, int height) {
 	// Destroy existing texture if it exists
 	if (intermediateTexture_) {
-		SDL_DestroyTexture(intermediateTexture_);
+		TextureRegistry::destroy(intermediateTexture_);
 		intermediateTexture_ = nullptr;
 	}
 
 	// Create the intermediate texture with alpha support
-	intermediateTexture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+	intermediateTexture_ = TextureRegistry::create(renderer, TextureRegistry::OwnerTarget, baseViewInfo.Monitor,
+		SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
 	if (!intermediateTexture_) {
 		LOG_ERROR("ReloadableHiscores", "Failed to create intermediate texture: " + std::string(SDL_GetError()));
 		return false;
@@ -594,7 +593,7 @@ bool ReloadableHiscores::createIntermediateTexture(SDL_Renderer* renderer, int w
 	// Set the blend mode to allow transparency
 	if (SDL_SetTextureBlendMode(intermediateTexture_, SDL_BLENDMODE_BLEND) != 0) {
 		LOG_ERROR("ReloadableHiscores", "Failed to set blend mode for intermediate texture: " + std::string(SDL_GetError()));
-		SDL_DestroyTexture(intermediateTexture_);
+		TextureRegistry::destroy(intermediateTexture_);
 		intermediateTexture_ = nullptr;
 		return false;
 	}
@@ -33,6 +33,7 @@ public:
         float scrollingSpeed, float startTime, std::string excludedColumns, float baseColumnPadding, float baseRowPadding, size_t maxRows);
     ~ReloadableHiscores() override;
     bool     update(float dt) override;
+    bool     updatesSerially() const override { return true; }
     void     draw() override;
     void     allocateGraphicsMemory() override;
     void     freeGraphicsMemory() override;
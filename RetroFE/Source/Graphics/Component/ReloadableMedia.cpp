@@ -74,7 +74,7 @@ bool ReloadableMedia::update(float dt)
         newScrollItemSelected = false;
         Component* foundComponent = reloadTexture();  // Removed the re-declaration here.
         if (foundComponent) {
-            foundComponent->playlistName = page.getPlaylistName();
+            foundComponent->setPlaylist(page.getPlaylistName());
             foundComponent->allocateGraphicsMemory();
             baseViewInfo.ImageWidth = foundComponent->baseViewInfo.ImageWidth;
             baseViewInfo.ImageHeight = foundComponent->baseViewInfo.ImageHeight;
@@ -494,7 +494,7 @@ Component* ReloadableMedia::findComponent(
             component = videoBuild.createVideo(imagePath, page, basename, baseViewInfo.Monitor);
     }
     else {
-        component = imageBuild.CreateImage(imagePath, page, basename, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCache_);
+        component = imageBuild.CreateImage(imagePath, page, basename, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCache_);
     }
 
     return component;
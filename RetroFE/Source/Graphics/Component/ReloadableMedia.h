@@ -32,6 +32,7 @@ public:
     ~ReloadableMedia() override;
     void enableTextureCache_(bool value);
     bool update(float dt) override;
+    bool updatesSerially() const override { return true; }
     void draw() override;
     void freeGraphicsMemory() override;
     void allocateGraphicsMemory() override;
@@ -34,6 +34,7 @@ public:
     ReloadableScrollingText(Configuration& config, bool systemMode, bool layoutMode, bool menuMode, std::string type, std::string textFormat, std::string singlePrefix, std::string singlePostfix, std::string pluralPrefix, std::string pluralPostfix, std::string alignment, Page& p, int displayOffset, FontManager* font, std::string direction, float scrollingSpeed, float startPosition, float startTime, float endTime, std::string location);
     virtual ~ReloadableScrollingText( );
     bool     update(float dt);
+    bool     updatesSerially() const override { return true; }
     void     draw( );
     void     allocateGraphicsMemory( );
     void     freeGraphicsMemory( );
@@ -102,9 +102,10 @@ void ReloadableText::deInitializeFonts()
 // Add a method to check the transition state
 bool ReloadableText::isInTransition() const
 {
-    return (getAnimationRequestedType() == "playlistExit" || getAnimationRequestedType() == "playlistPrevEnter" ||
-            getAnimationRequestedType() == "playlistPrevExit" || getAnimationRequestedType() == "playlistNextEnter" ||
-            getAnimationRequestedType() == "playlistNextExit");
+    AnimationEvent event = getAnimationRequestedType();
+    return (event == ANIMATION_EVENT_PLAYLIST_EXIT || event == ANIMATION_EVENT_PLAYLIST_PREV_ENTER ||
+            event == ANIMATION_EVENT_PLAYLIST_PREV_EXIT || event == ANIMATION_EVENT_PLAYLIST_NEXT_ENTER ||
+            event == ANIMATION_EVENT_PLAYLIST_NEXT_EXIT);
 }
 
 void ReloadableText::ReloadTexture()
@@ -29,6 +29,7 @@ public:
     ReloadableText(std::string type, Page &page, Configuration &config, bool systemMode, FontManager *font, std::string layoutKey, std::string timeFormat, std::string textFormat, std::string singlePrefix, std::string singlePostfix, std::string pluralPrefix, std::string pluralPostfix, std::string location = "");
     virtual ~ReloadableText();
     bool     update(float dt);
+    bool     updatesSerially() const override { return true; }
     void     draw();
     void     freeGraphicsMemory();
     void     allocateGraphicsMemory();
@@ -528,112 +528,112 @@ void ScrollingList::freeGraphicsMemory()
 
 void ScrollingList::triggerEnterEvent( )
 {
-    triggerEventOnAll("enter", 0);
+    triggerEventOnAll(ANIMATION_EVENT_ENTER, 0);
 }
 
 void ScrollingList::triggerExitEvent( )
 {
-    triggerEventOnAll("exit", 0);
+    triggerEventOnAll(ANIMATION_EVENT_EXIT, 0);
 }
 
 void ScrollingList::triggerMenuEnterEvent( int menuIndex )
 {
-    triggerEventOnAll("menuEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_MENU_ENTER, menuIndex);
 }
 
 void ScrollingList::triggerMenuExitEvent( int menuIndex )
 {
-    triggerEventOnAll("menuExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_MENU_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerGameEnterEvent( int menuIndex )
 {
-    triggerEventOnAll("gameEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_GAME_ENTER, menuIndex);
 }
 
 void ScrollingList::triggerGameExitEvent( int menuIndex )
 {
-    triggerEventOnAll("gameExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_GAME_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerHighlightEnterEvent( int menuIndex )
 {
-    triggerEventOnAll("highlightEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_HIGHLIGHT_ENTER, menuIndex);
 }
 
 void ScrollingList::triggerHighlightExitEvent( int menuIndex )
 {
-    triggerEventOnAll("highlightExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_HIGHLIGHT_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerPlaylistEnterEvent( int menuIndex )
 {
-    triggerEventOnAll("playlistEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_PLAYLIST_ENTER, menuIndex);
 }
 
 void ScrollingList::triggerPlaylistExitEvent( int menuIndex )
 {
-    triggerEventOnAll("playlistExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_PLAYLIST_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerMenuJumpEnterEvent( int menuIndex )
 {
-    triggerEventOnAll("menuJumpEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_MENU_JUMP_ENTER, menuIndex);
 }
 
 void ScrollingList::triggerMenuJumpExitEvent( int menuIndex )
 {
-    triggerEventOnAll("menuJumpExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_MENU_JUMP_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerAttractEnterEvent( int menuIndex )
 {
-    triggerEventOnAll("attractEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_ATTRACT_ENTER, menuIndex);
 }
 
 void ScrollingList::triggerAttractEvent( int menuIndex )
 {
-    triggerEventOnAll("attract", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_ATTRACT, menuIndex);
 }
 
 void ScrollingList::triggerAttractExitEvent( int menuIndex )
 {
-    triggerEventOnAll("attractExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_ATTRACT_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerGameInfoEnter(int menuIndex)
 {
-    triggerEventOnAll("gameInfoEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_GAME_INFO_ENTER, menuIndex);
 }
 void ScrollingList::triggerGameInfoExit(int menuIndex)
 {
-    triggerEventOnAll("gameInfoExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_GAME_INFO_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerCollectionInfoEnter(int menuIndex)
 {
-    triggerEventOnAll("collectionInfoEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_COLLECTION_INFO_ENTER, menuIndex);
 }
 void ScrollingList::triggerCollectionInfoExit(int menuIndex)
 {
-    triggerEventOnAll("collectionInfoExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_COLLECTION_INFO_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerBuildInfoEnter(int menuIndex)
 {
-    triggerEventOnAll("buildInfoEnter", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_BUILD_INFO_ENTER, menuIndex);
 }
 void ScrollingList::triggerBuildInfoExit(int menuIndex)
 {
-    triggerEventOnAll("buildInfoExit", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_BUILD_INFO_EXIT, menuIndex);
 }
 
 void ScrollingList::triggerJukeboxJumpEvent( int menuIndex )
 {
-    triggerEventOnAll("jukeboxJump", menuIndex);
+    triggerEventOnAll(ANIMATION_EVENT_JUKEBOX_JUMP, menuIndex);
 }
 
-void ScrollingList::triggerEventOnAll(const std::string& event, int menuIndex)
+void ScrollingList::triggerEventOnAll(AnimationEvent event, int menuIndex)
 {
     size_t componentSize = components_.size();
     for (size_t i = 0; i < componentSize; ++i) {
@@ -656,7 +656,9 @@ bool ScrollingList::update(float dt)
     for (unsigned int i = 0; i < scrollPointsSize; i++) {
         Component *c = components_[i];
         if (c) {
-            c->playlistName = playlistName;
+            if (c->getPlaylistId() != getPlaylistId()) {
+                c->setPlaylist(playlistName);
+            }
             done &= c->update(dt);
         }
     }
@@ -693,34 +695,50 @@ void ScrollingList::resetTweens(Component* c, std::shared_ptr<AnimationEvents> s
 
     c->setTweens(sets);
 
-    std::shared_ptr<Animation> scrollTween = sets->getAnimation("menuScroll");
-    scrollTween->Clear();
+    // Every scroll re-parameterizes the set built on the first one, fast
+    // scrolling does this for each slot many times a second
+    constexpr size_t scrollTweenCount = 18; // restart or a no-op, then 17 properties
+    std::shared_ptr<Animation> scrollTween = sets->getAnimation(ANIMATION_EVENT_MENU_SCROLL);
+    std::shared_ptr<TweenSet> set = scrollTween->size() == 1 ? scrollTween->tweenSet(0) : nullptr;
+    if (!set || set->size() != scrollTweenCount) {
+        scrollTween->Clear();
+        set = std::make_shared<TweenSet>();
+        for (size_t i = 0; i < scrollTweenCount; ++i) {
+            set->push(std::make_unique<Tween>(TWEEN_PROPERTY_NOP, LINEAR, 0, 0, 0));
+        }
+        scrollTween->Push(set);
+    }
     c->baseViewInfo = *currentViewInfo;
 
-    auto set = std::make_unique<TweenSet>();
+    unsigned int index = 0;
+    auto tween = [&set, &index](TweenProperty property, double start, double end, double duration) {
+        set->getTween(index++)->reset(property, LINEAR, start, end, duration);
+    };
+
     if (currentViewInfo->Restart && scrollPeriod_ > minScrollTime_) {
-        set->push(std::make_unique<Tween>(TWEEN_PROPERTY_RESTART, LINEAR, currentViewInfo->Restart, nextViewInfo->Restart, 0));
+        tween(TWEEN_PROPERTY_RESTART, currentViewInfo->Restart, nextViewInfo->Restart, 0);
+    }
+    else {
+        tween(TWEEN_PROPERTY_NOP, 0, 0, 0);
     }
 
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_HEIGHT, LINEAR, currentViewInfo->Height, nextViewInfo->Height, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_WIDTH, LINEAR, currentViewInfo->Width, nextViewInfo->Width, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_ANGLE, LINEAR, currentViewInfo->Angle, nextViewInfo->Angle, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_ALPHA, LINEAR, currentViewInfo->Alpha, nextViewInfo->Alpha, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_X, LINEAR, currentViewInfo->X, nextViewInfo->X, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_Y, LINEAR, currentViewInfo->Y, nextViewInfo->Y, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_X_ORIGIN, LINEAR, currentViewInfo->XOrigin, nextViewInfo->XOrigin, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_Y_ORIGIN, LINEAR, currentViewInfo->YOrigin, nextViewInfo->YOrigin, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_X_OFFSET, LINEAR, currentViewInfo->XOffset, nextViewInfo->XOffset, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_Y_OFFSET, LINEAR, currentViewInfo->YOffset, nextViewInfo->YOffset, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_FONT_SIZE, LINEAR, currentViewInfo->FontSize, nextViewInfo->FontSize, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_BACKGROUND_ALPHA, LINEAR, currentViewInfo->BackgroundAlpha, nextViewInfo->BackgroundAlpha, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_MAX_WIDTH, LINEAR, currentViewInfo->MaxWidth, nextViewInfo->MaxWidth, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_MAX_HEIGHT, LINEAR, currentViewInfo->MaxHeight, nextViewInfo->MaxHeight, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_LAYER, LINEAR, currentViewInfo->Layer, nextViewInfo->Layer, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_VOLUME, LINEAR, currentViewInfo->Volume, nextViewInfo->Volume, scrollTime));
-    set->push(std::make_unique<Tween>(TWEEN_PROPERTY_MONITOR, LINEAR, currentViewInfo->Monitor, nextViewInfo->Monitor, scrollTime));
-
-    scrollTween->Push(std::move(set));
+    tween(TWEEN_PROPERTY_HEIGHT, currentViewInfo->Height, nextViewInfo->Height, scrollTime);
+    tween(TWEEN_PROPERTY_WIDTH, currentViewInfo->Width, nextViewInfo->Width, scrollTime);
+    tween(TWEEN_PROPERTY_ANGLE, currentViewInfo->Angle, nextViewInfo->Angle, scrollTime);
+    tween(TWEEN_PROPERTY_ALPHA, currentViewInfo->Alpha, nextViewInfo->Alpha, scrollTime);
+    tween(TWEEN_PROPERTY_X, currentViewInfo->X, nextViewInfo->X, scrollTime);
+    tween(TWEEN_PROPERTY_Y, currentViewInfo->Y, nextViewInfo->Y, scrollTime);
+    tween(TWEEN_PROPERTY_X_ORIGIN, currentViewInfo->XOrigin, nextViewInfo->XOrigin, scrollTime);
+    tween(TWEEN_PROPERTY_Y_ORIGIN, currentViewInfo->YOrigin, nextViewInfo->YOrigin, scrollTime);
+    tween(TWEEN_PROPERTY_X_OFFSET, currentViewInfo->XOffset, nextViewInfo->XOffset, scrollTime);
+    tween(TWEEN_PROPERTY_Y_OFFSET, currentViewInfo->YOffset, nextViewInfo->YOffset, scrollTime);
+    tween(TWEEN_PROPERTY_FONT_SIZE, currentViewInfo->FontSize, nextViewInfo->FontSize, scrollTime);
+    tween(TWEEN_PROPERTY_BACKGROUND_ALPHA, currentViewInfo->BackgroundAlpha, nextViewInfo->BackgroundAlpha, scrollTime);
+    tween(TWEEN_PROPERTY_MAX_WIDTH, currentViewInfo->MaxWidth, nextViewInfo->MaxWidth, scrollTime);
+    tween(TWEEN_PROPERTY_MAX_HEIGHT, currentViewInfo->MaxHeight, nextViewInfo->MaxHeight, scrollTime);
+    tween(TWEEN_PROPERTY_LAYER, currentViewInfo->Layer, nextViewInfo->Layer, scrollTime);
+    tween(TWEEN_PROPERTY_VOLUME, currentViewInfo->Volume, nextViewInfo->Volume, scrollTime);
+    tween(TWEEN_PROPERTY_MONITOR, currentViewInfo->Monitor, nextViewInfo->Monitor, scrollTime);
 }
 
 bool ScrollingList::allocateTexture( size_t index, const Item *item )
@@ -807,7 +825,7 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
             }
             else {
                 std::string imageName = selectedImage_ && item->name == selectedItemName ? name + "-selected" : name;
-                t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
         }
 
@@ -831,7 +849,7 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
                 }
                 else {
                     std::string imageName = selectedImage_ && item->name == selectedItemName ? name + "-selected" : name;
-                    t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                    t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
                 }
             }
         }
@@ -867,10 +885,10 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
         else {
             name = imageType_;
             if (selectedImage_ && item->name == selectedItemName) {
-                t = imageBuild.CreateImage(imagePath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(imagePath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
             if (!t) {
-                t = imageBuild.CreateImage(imagePath, page, name, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(imagePath, page, name, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
         }
     }
@@ -883,10 +901,10 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
         else {
             name = imageType_;
             if (selectedImage_ && item->name == selectedItemName) {
-                t = imageBuild.CreateImage(item->filepath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(item->filepath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
             if (!t) {
-                t = imageBuild.CreateImage(item->filepath, page, name, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(item->filepath, page, name, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
         }
     }
@@ -914,7 +932,7 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
 
             // Try to create image
             std::string imageName = selectedImage_ && item->name == selectedItemName ? name + "-selected" : name;
-            t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+            t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
 
             // Check sub-collection path for art if needed
             if (!t && !commonMode_) {
@@ -929,7 +947,7 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
 
                 // Try to create image again
                 imageName = selectedImage_ && item->name == selectedItemName ? name + "-selected" : name;
-                t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(imagePath, page, imageName, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
         }
 
@@ -954,10 +972,10 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
             if ( !t ) {
                 name = imageType_;
                 if (selectedImage_ && item->name == selectedItemName) {
-                    t = imageBuild.CreateImage(imagePath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                    t = imageBuild.CreateImage(imagePath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
                 }
                 if (!t) {
-                    t = imageBuild.CreateImage(imagePath, page, name, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                    t = imageBuild.CreateImage(imagePath, page, name, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
                 }
             }
         }
@@ -965,10 +983,10 @@ bool ScrollingList::allocateTexture( size_t index, const Item *item )
         if ( !t ) {
             name = imageType_;
             if (selectedImage_ && item->name == selectedItemName) {
-                t = imageBuild.CreateImage(item->filepath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(item->filepath, page, name + "-selected", baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
             if (!t) {
-                t = imageBuild.CreateImage(item->filepath, page, name, baseViewInfo.Monitor, baseViewInfo.Additive, useTextureCaching_);
+                t = imageBuild.CreateImage(item->filepath, page, name, baseViewInfo.Monitor, baseViewInfo.style().Additive, useTextureCaching_);
             }
         }
 
@@ -1108,7 +1126,7 @@ void ScrollingList::scroll(bool forward)
             component->allocateGraphicsMemory();
             resetTweens(component, nextTweenPoint, currentScrollPoint, nextScrollPoint, scrollPeriod_);
             component->baseViewInfo.font = nextScrollPoint->font;
-            component->triggerEvent("menuScroll");
+            component->triggerEvent(ANIMATION_EVENT_MENU_SCROLL);
         }
     }
 
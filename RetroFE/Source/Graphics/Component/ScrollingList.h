@@ -128,7 +128,7 @@ public:
     void triggerBuildInfoEnter(int menuIndex = -1);
     void triggerBuildInfoExit(int menuIndex = -1);
     void triggerJukeboxJumpEvent(int menuIndex = -1);
-    void triggerEventOnAll(const std::string& event, int menuIndex);;
+    void triggerEventOnAll(AnimationEvent event, int menuIndex);
 
     bool allocateTexture(size_t index, const Item* i);
     void buildPaths(std::string& imagePath, std::string& videoPath, const std::string& base, const std::string& subPath, const std::string& mediaType, const std::string& videoType);
@@ -164,6 +164,7 @@ public:
     void allocateGraphicsMemory() override;
     void freeGraphicsMemory() override;
     bool update(float dt) override;
+    bool updatesSerially() const override { return true; }
     const std::vector<Component*>& getComponents() const;
     void setScrollAcceleration(float value);
     void setStartScrollTime(float value);
@@ -124,7 +124,7 @@ bool VideoComponent::update(float dt) {
 			hasBeenOnScreen_ = true;
 		}
 
-		if (baseViewInfo.PauseOnScroll) {
+		if (baseViewInfo.style().PauseOnScroll) {
 			if (!isCurrentlyVisible && !isPaused && !currentPage_->isMenuFastScrolling()) {
 				pause();
 				LOG_DEBUG("VideoComponent", "Paused " + Utils::getFileName(videoFile_));
@@ -32,7 +32,9 @@ public:
     explicit VideoComponent(Page& p, const std::string& videoFile, int monitor, int numLoops, bool softOverlay, int listID, const int* perspectiveCorners);
     ~VideoComponent() override;
     bool update(float dt) override;
+    bool updatesSerially() const override { return true; }
     void draw() override;
+    bool drawsWithinView() const override { return true; }
     void freeGraphicsMemory() override;
     void allocateGraphicsMemory() override;
     bool isPlaying() override;
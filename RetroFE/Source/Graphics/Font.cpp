@@ -15,6 +15,7 @@
 */
 #include "Font.h"
 #include "../SDL.h"
+#include "TextureRegistry.h"
 #include "../Utility/Log.h"
 #include <SDL2/SDL.h>
 #if __has_include(<SDL2/SDL_ttf.h>)
@@ -169,8 +170,9 @@ bool FontManager::initialize() {
     }
 
     SDL_LockMutex(SDL::getMutex());
-    texture = SDL_CreateTextureFromSurface(SDL::getRenderer(monitor_), atlasSurface);
+    texture = TextureRegistry::createFromSurface(SDL::getRenderer(monitor_), TextureRegistry::OwnerFont, monitor_, atlasSurface);
     SDL_UnlockMutex(SDL::getMutex());
+    SDL::invalidate(texture);
 
     if (!texture) {
         LOG_WARNING("Font", "Failed to create texture from surface.");
@@ -189,7 +191,7 @@ bool FontManager::initialize() {
 void FontManager::deInitialize() {
     // Destroy the atlas texture if it exists
     if (texture) {
-        SDL_DestroyTexture(texture);
+        TextureRegistry::destroy(texture);
         texture = nullptr;
     }
 
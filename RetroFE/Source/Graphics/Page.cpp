@@ -27,9 +27,12 @@
 #include "../Utility/Utils.h"
 #include "../Database/GlobalOpts.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
-
 Page::Page(Configuration &config, int layoutWidth, int layoutHeight)
     : fromPreviousPlaylist (false)
     , fromPlaylistNav(false)
@@ -391,7 +394,7 @@ void Page::start()
     for(auto it = menus_.begin(); it != menus_.end(); ++it) {
         for(auto it2 = it->begin(); it2 != it->end(); ++it2) {
             ScrollingList *menu = *it2;
-            menu->triggerEvent( "enter" );
+            menu->triggerEvent( ANIMATION_EVENT_ENTER );
             menu->triggerEnterEvent();
         }
     }
@@ -403,7 +406,7 @@ void Page::start()
     // Trigger "enter" events for all components, iterating from lowest to highest layer
     for (const auto& layer : LayerComponents_) {
         for (Component* component : layer) {
-            component->triggerEvent("enter");
+            component->triggerEvent(ANIMATION_EVENT_ENTER);
         }
     }
 }
@@ -414,7 +417,7 @@ void Page::stop()
     for(auto it = menus_.begin(); it != menus_.end(); ++it) {
         for(auto it2 = it->begin(); it2 != it->end(); ++it2) {
             ScrollingList *menu = *it2;
-            menu->triggerEvent( "exit" );
+            menu->triggerEvent( ANIMATION_EVENT_EXIT );
             menu->triggerExitEvent();
         }
     }
@@ -426,7 +429,7 @@ void Page::stop()
     // Trigger "exit" events for all components, iterating from highest to lowest layer
     for (auto it = LayerComponents_.rbegin(); it != LayerComponents_.rend(); ++it) {
         for (Component* component : *it) {
-            component->triggerEvent("exit");
+            component->triggerEvent(ANIMATION_EVENT_EXIT);
         }
     }
 }
@@ -548,7 +551,7 @@ void Page::menuScroll()
 
     for (auto& layer : LayerComponents_) {
         for (Component* component : layer) {
-            component->triggerEvent("menuScroll", menuDepth_ - 1);
+            component->triggerEvent(ANIMATION_EVENT_MENU_SCROLL, menuDepth_ - 1);
         }
     }
 }
@@ -560,44 +563,44 @@ void Page::playlistScroll()
 
     for (auto& layer : LayerComponents_) {
         for (Component* component : layer) {
-            component->triggerEvent("playlistScroll", menuDepth_ - 1);
+            component->triggerEvent(ANIMATION_EVENT_PLAYLIST_SCROLL, menuDepth_ - 1);
         }
     }
 }
 
 void Page::highlightEnter()
 {
-    triggerEventOnAllMenus("highlightEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_HIGHLIGHT_ENTER);
 }
 
 void Page::highlightExit()
 {
-    triggerEventOnAllMenus("highlightExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_HIGHLIGHT_EXIT);
 }
 
 void Page::playlistEnter()
 {
     // entered in new playlist set selected item
     setSelectedItem();
-    triggerEventOnAllMenus("playlistEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_PLAYLIST_ENTER);
 }
 
 void Page::playlistExit()
 {
-    triggerEventOnAllMenus("playlistExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_PLAYLIST_EXIT);
 }
 
 void Page::playlistNextEnter()
 {
     fromPlaylistNav = true;
     fromPreviousPlaylist = false;
-    triggerEventOnAllMenus("playlistNextEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_PLAYLIST_NEXT_ENTER);
 }
 
 void Page::playlistNextExit()
 {
     fromPreviousPlaylist = false;
-    triggerEventOnAllMenus("playlistNextExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_PLAYLIST_NEXT_EXIT);
     fromPlaylistNav = false;
 }
 
@@ -605,13 +608,13 @@ void Page::playlistPrevEnter()
 {
     fromPlaylistNav = true;
     fromPreviousPlaylist = true;
-    triggerEventOnAllMenus("playlistPrevEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_PLAYLIST_PREV_ENTER);
 }
 
 void Page::playlistPrevExit()
 {
     fromPreviousPlaylist = true;
-    triggerEventOnAllMenus("playlistPrevExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_PLAYLIST_PREV_EXIT);
     fromPlaylistNav = false;
 }
 
@@ -619,63 +622,63 @@ void Page::menuJumpEnter()
 {
     // jumped into new item
     setSelectedItem();
-    triggerEventOnAllMenus("menuJumpEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_MENU_JUMP_ENTER);
 }
 
 void Page::menuJumpExit()
 {
-    triggerEventOnAllMenus("menuJumpExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_MENU_JUMP_EXIT);
 }
 
 
 void Page::attractEnter()
 {
-    triggerEventOnAllMenus("attractEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_ATTRACT_ENTER);
 }
 
 void Page::attract()
 {
-    triggerEventOnAllMenus("attract");
+    triggerEventOnAllMenus(ANIMATION_EVENT_ATTRACT);
 }
 
 void Page::attractExit()
 {
-    triggerEventOnAllMenus("attractExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_ATTRACT_EXIT);
 }
 
 void Page::gameInfoEnter()
 {
-    triggerEventOnAllMenus("gameInfoEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_GAME_INFO_ENTER);
 }
 void Page::gameInfoExit()
 {
-    triggerEventOnAllMenus("gameInfoExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_GAME_INFO_EXIT);
 }
 
 void Page::collectionInfoEnter()
 {
-    triggerEventOnAllMenus("collectionInfoEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_COLLECTION_INFO_ENTER);
 }
 void Page::collectionInfoExit()
 {
-    triggerEventOnAllMenus("collectionInfoExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_COLLECTION_INFO_EXIT);
 }
 
 void Page::buildInfoEnter()
 {
-    triggerEventOnAllMenus("buildInfoEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_BUILD_INFO_ENTER);
 }
 void Page::buildInfoExit()
 {
-    triggerEventOnAllMenus("buildInfoExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_BUILD_INFO_EXIT);
 }
 
 void Page::jukeboxJump()
 {
-    triggerEventOnAllMenus("jukeboxJump");
+    triggerEventOnAllMenus(ANIMATION_EVENT_JUKEBOX_JUMP);
 }
 
-void Page::triggerEventOnAllMenus(const std::string& event)
+void Page::triggerEventOnAllMenus(AnimationEvent event)
 {
     if (!selectedItem_)
         return;
@@ -701,12 +704,12 @@ void Page::triggerEventOnAllMenus(const std::string& event)
 
 
 
-void Page::triggerEvent(const std::string& action)
+void Page::triggerEvent(AnimationEvent event)
 {
     for (auto& layer : LayerComponents_) {
         for (Component* component : layer) {
             if (component)
-                component->triggerEvent(action);
+                component->triggerEvent(event);
         }
     }
 }
@@ -1037,25 +1040,25 @@ bool Page::popCollection()
 
 void Page::enterMenu()
 {
-    triggerEventOnAllMenus("menuEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_MENU_ENTER);
 }
 
 
 void Page::exitMenu()
 {
-    triggerEventOnAllMenus("menuExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_MENU_EXIT);
 }
 
 
 void Page::enterGame()
 {
-    triggerEventOnAllMenus("gameEnter");
+    triggerEventOnAllMenus(ANIMATION_EVENT_GAME_ENTER);
 }
 
 
 void Page::exitGame()
 {
-    triggerEventOnAllMenus("gameExit");
+    triggerEventOnAllMenus(ANIMATION_EVENT_GAME_EXIT);
 }
 
 
@@ -1080,6 +1083,8 @@ void Page::nextPlaylist()
 {
     MenuInfo_S &info = collections_.back();
     size_t numlists = info.collection->playlists.size();
+    // the search results are only reachable through search() unless active
+    bool inSearch = getPlaylistName() == "search";
     // save last playlist selected item
     rememberSelectedItem();
 
@@ -1090,7 +1095,7 @@ void Page::nextPlaylist()
             playlist_ = info.collection->playlists.begin();
 
         // find the first playlist
-        if(!playlist_->second->empty()) 
+        if(!playlist_->second->empty() && (inSearch || playlist_->first != "search")) 
             break;
     }
 
@@ -1106,6 +1111,8 @@ void Page::prevPlaylist()
 {
     MenuInfo_S &info = collections_.back();
     size_t numlists = info.collection->playlists.size();
+    // the search results are only reachable through search() unless active
+    bool inSearch = getPlaylistName() == "search";
     // save last playlist selected item
     rememberSelectedItem();
 
@@ -1117,7 +1124,7 @@ void Page::prevPlaylist()
         playlist_--;
 
         // find the first playlist
-        if(!playlist_->second->empty()) 
+        if(!playlist_->second->empty() && (inSearch || playlist_->first != "search")) 
             break;
     }
 
@@ -1276,6 +1283,31 @@ void Page::prevCyclePlaylist(std::vector<std::string> list)
     selectPlaylist(prevPlaylist);
 }
 
+void Page::search(const std::string& query)
+{
+    if (collections_.empty())
+        return;
+
+    // Leave the search playlist before its contents change underneath the menus
+    if (getPlaylistName() == "search")
+        selectPlaylist("all");
+
+    CollectionInfo* collection = collections_.back().collection;
+    if (!collection->search(query))
+        return;
+
+    lastPlaylistOffsets_.erase("search");
+    selectPlaylist("search");
+}
+
+std::map<std::string, size_t, std::less<>> Page::searchFacets(const std::string& field) const
+{
+    if (collections_.empty())
+        return {};
+
+    return collections_.back().collection->searchFacets(field);
+}
+
 bool Page::playlistExists(const std::string& playlist)
 {
     MenuInfo_S& info = collections_.back();
@@ -1296,76 +1328,56 @@ void Page::update(float dt) {
         playlistNameChanged = true;
     }
 
-    if (useThreading_) {
-        // Asynchronous (threaded) version for non-OpenGL backends
-
-        // Future for asynchronous update of ScrollingLists within menus_
-        auto menuUpdateFuture = pool_.enqueue([this, dt, playlistNameChanged]() {
-            for (auto& menuList : menus_) {
-                for (auto* menu : menuList) {
-                    if (playlistNameChanged) {
-                        menu->playlistName = lastPlaylistName_;
-                    }
-                    menu->update(dt);
-                }
+    // Menus and the components that share state with others are updated
+    // one after another, and before the rest so nothing runs beside them
+    for (auto& menuList : menus_) {
+        for (auto* menu : menuList) {
+            if (playlistNameChanged) {
+                menu->setPlaylist(lastPlaylistName_);
             }
-            });
+            menu->update(dt);
+        }
+    }
 
-        // Future for asynchronous update of LayerComponents
-        auto layerUpdateFuture = pool_.enqueue([this, dt, playlistNameChanged]() {
-            for (auto& layer : LayerComponents_) {
-                for (auto it = layer.begin(); it != layer.end();) {
-                    if (*it) {
-                        if (playlistNameChanged) {
-                            (*it)->playlistName = lastPlaylistName_;
-                        }
-                        if ((*it)->update(dt) && (*it)->getAnimationDoneRemove()) {
-                            (*it)->freeGraphicsMemory();
-                            delete *it;
-                            it = layer.erase(it);
-                        } else {
-                            ++it;
-                        }
-                    } else {
-                        ++it;
-                    }
-                }
+    parallelUpdates_.clear();
+    for (auto& layer : LayerComponents_) {
+        for (Component* component : layer) {
+            if (!component) {
+                continue;
             }
-            });
-
-        // Wait for asynchronous operations to complete
-        menuUpdateFuture.get();
-        layerUpdateFuture.get();
-    } else {
-        // Synchronous (non-threaded) version for OpenGL backend
+            if (playlistNameChanged) {
+                component->setPlaylist(lastPlaylistName_);
+            }
+            if (useThreading_ && !component->updatesSerially()) {
+                parallelUpdates_.push_back(component);
+            }
+            else if (component->update(dt) && component->getAnimationDoneRemove()) {
+                removals_.push_back(component);
+            }
+        }
+    }
 
-        for (auto& menuList : menus_) {
-            for (auto* menu : menuList) {
-                if (playlistNameChanged) {
-                    menu->playlistName = lastPlaylistName_;
-                }
-                menu->update(dt);
+    if (!parallelUpdates_.empty()) {
+        updateInParallel(dt);
+        for (size_t i = 0; i < parallelUpdates_.size(); ++i) {
+            if (parallelDone_[i] && parallelUpdates_[i]->getAnimationDoneRemove()) {
+                removals_.push_back(parallelUpdates_[i]);
             }
         }
+    }
 
+    // Removed once nothing iterates the layers anymore
+    if (!removals_.empty()) {
         for (auto& layer : LayerComponents_) {
-            for (auto it = layer.begin(); it != layer.end();) {
-                if (*it) {
-                    if (playlistNameChanged) {
-                        (*it)->playlistName = lastPlaylistName_;
-                    }
-                    if ((*it)->update(dt) && (*it)->getAnimationDoneRemove()) {
-                        (*it)->freeGraphicsMemory();
-                        delete *it;
-                        it = layer.erase(it);
-                    } else {
-                        ++it;
-                    }
-                } else {
-                    ++it;
-                }
-            }
+            layer.erase(std::remove_if(layer.begin(), layer.end(), [this](const Component* component) {
+                return std::find(removals_.begin(), removals_.end(), component) != removals_.end();
+                }), layer.end());
+        }
+        for (Component* component : removals_) {
+            component->freeGraphicsMemory();
+            delete component;
         }
+        removals_.clear();
     }
 
     // Common update code for textStatusComponent_
@@ -1374,6 +1386,10 @@ void Page::update(float dt) {
         config_.setProperty("status", status);
         textStatusComponent_->setText(status);
     }
+
+    // Evaluate the tweens of everything updated above. Until here the
+    // components saw last frame's values, the draw sees this frame's.
+    tweenEngine_.update();
 }
 
 
@@ -1386,6 +1402,65 @@ void Page::updateReloadables(float dt)
             }
         }
     }
+    tweenEngine_.update();
+}
+
+// The components are split in chunks that the pool's threads and this one take
+// in turn until none are left, so a few slow components do not hold up the rest
+void Page::updateInParallel(float dt)
+{
+    // Outlives this call for helpers that only start once every chunk is done
+    struct Chunks
+    {
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> left{ 0 };
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    constexpr size_t chunkSize = 8;
+    size_t count = parallelUpdates_.size();
+    size_t chunks = (count + chunkSize - 1) / chunkSize;
+    parallelDone_.assign(count, 0);
+
+    auto state = std::make_shared<Chunks>();
+    state->left = chunks;
+    Component* const* components = parallelUpdates_.data();
+    char* results = parallelDone_.data();
+    auto work = [state, components, results, dt, count, chunks]() {
+        for (size_t chunk = state->next++; chunk < chunks; chunk = state->next++) {
+            size_t end = std::min(count, (chunk + 1) * chunkSize);
+            for (size_t i = chunk * chunkSize; i < end; ++i) {
+                results[i] = components[i]->update(dt);
+            }
+            if (--state->left == 0) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::shared();
+    size_t helperCount = std::min(pool.size(), chunks - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        pool.post(work, ThreadPool::PriorityFrame);
+    }
+    work();
+
+    // Only the chunks helpers took are waited for, not helpers stuck behind
+    // long background tasks
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]() { return state->left == 0; });
+}
+
+void Page::setThreading(bool threading)
+{
+    useThreading_ = threading;
+}
+
+TweenEngine& Page::getTweenEngine()
+{
+    return tweenEngine_;
 }
 
 void Page::cleanup()
@@ -1412,49 +1487,55 @@ void Page::cleanup()
 }
 
 
-void Page::draw() {
- 
-    for (unsigned int i = 0; i < NUM_LAYERS; ++i) {
-        // Check for out-of-bounds access
-        if (i >= LayerComponents_.size()) {
-            LOG_ERROR("Page::draw", "Layer index out of bounds: " + std::to_string(i));
-            break; // Exit loop
-        }
+void Page::draw(int monitor) {
+    // Bucket the visible components by layer once instead of scanning every
+    // menu for every layer
+    drawList_.resize(NUM_LAYERS);
+    for (auto& layer : drawList_) {
+        layer.clear();
+    }
 
-        // Skip layers with no components or menus
-        if (LayerComponents_[i].empty() && menus_.empty()) {
-            continue;
-        }
+    auto isDrawn = [monitor](const Component* c) {
+        return (monitor < 0 || c->baseViewInfo.Monitor == monitor) && !c->isCulled();
+    };
 
-        // Draw all components in the layer
+    for (unsigned int i = 0; i < NUM_LAYERS && i < LayerComponents_.size(); ++i) {
         for (Component* component : LayerComponents_[i]) {
             if (!component) {
                 LOG_WARNING("Page::draw", "Null component in LayerComponents_[" + std::to_string(i) + "].");
                 continue;
             }
-            component->draw();
+            if (isDrawn(component)) {
+                drawList_[i].push_back(component);
+            }
         }
+    }
 
-        // Draw all menus in the layer
-        for (const auto& menuList : menus_) {
-            for (ScrollingList* const menu : menuList) {
-                if (!menu) {
-                    LOG_WARNING("Page::draw", "Null menu in menus_.");
+    for (const auto& menuList : menus_) {
+        for (ScrollingList* const menu : menuList) {
+            if (!menu) {
+                LOG_WARNING("Page::draw", "Null menu in menus_.");
+                continue;
+            }
+
+            for (Component* c : menu->getComponents()) {
+                if (!c) {
+                    LOG_WARNING("Page::draw", "Null component in menu->getComponents().");
                     continue;
                 }
-
-                for (Component* c : menu->getComponents()) {
-                    if (!c) {
-                        LOG_WARNING("Page::draw", "Null component in menu->getComponents().");
-                        continue;
-                    }
-                    if (c->baseViewInfo.Layer == i) {
-                        c->draw();
-                    }
+                if (c->baseViewInfo.Layer < NUM_LAYERS && isDrawn(c)) {
+                    drawList_[c->baseViewInfo.Layer].push_back(c);
                 }
             }
         }
     }
+
+    for (unsigned int i = 0; i < NUM_LAYERS; ++i) {
+        SDL::setLayer(i);
+        for (Component* component : drawList_[i]) {
+            component->draw();
+        }
+    }
 }
 
 
@@ -1548,6 +1629,32 @@ CollectionInfo *Page::getCollection()
     return collections_.back().collection;
 }
 
+std::vector<CollectionInfo *> Page::getCollections() const
+{
+    std::vector<CollectionInfo *> collections;
+    for (MenuInfo_S const &info : collections_) {
+        collections.push_back(info.collection);
+    }
+    return collections;
+}
+
+// Reloads the visible menu items after the collection was re-sorted or its
+// metadata changed, keeping the selected item selected
+void Page::refreshItems()
+{
+    if (!getAnActiveMenu()) return;
+
+    std::string selectedName = selectedItem_ ? selectedItem_->name : "";
+    for (ScrollingList *menu : activeMenu_) {
+        if (menu && !menu->isPlaylist() && menu->getSize() && !selectedName.empty()) {
+            menu->selectItemByName(selectedName);
+        }
+    }
+    reallocateMenuSpritePoints(false);
+    selectedItem_ = getSelectedMenuItem();
+    onNewItemSelected();
+}
+
 
 void Page::freeGraphicsMemory()
 {
@@ -1729,7 +1836,7 @@ bool Page::isMenuFastScrolling() const
 void Page::scroll(bool forward, bool playlist) {
     if (useThreading_) {
         // Asynchronous version
-        auto scrollFuture = pool_.enqueue([this, forward, playlist]() {
+        auto scrollFuture = ThreadPool::shared().enqueue([this, forward, playlist]() {
             for (auto& menu : activeMenu_) {
                 if (menu && ((playlist && menu->isPlaylist()) || (!playlist && !menu->isPlaylist()))) {
                     menu->scroll(forward);
@@ -17,6 +17,7 @@
 
 #include "../Collection/CollectionInfo.h"
 #include "ThreadPool.h"
+#include "Animate/TweenEngine.h"
 
 #include <map>
 #include <string>
@@ -35,8 +36,7 @@ class Page
 
 public:
 
-    ThreadPool pool_{ 4 };
-    ;    enum ScrollDirection
+    enum ScrollDirection
     {
         ScrollDirectionForward,
         ScrollDirectionBack,
@@ -65,6 +65,8 @@ public:
     void nextPlaylist();
     void prevPlaylist();
     void selectPlaylist(const std::string& playlist);
+    void search(const std::string& query);
+    std::map<std::string, size_t, std::less<>> searchFacets(const std::string& field) const;
     void nextCyclePlaylist(std::vector<std::string> list);
     void prevCyclePlaylist(std::vector<std::string> list);
     void pushMenu(ScrollingList *s, int index = -1);
@@ -107,9 +109,12 @@ public:
     bool isMenuIdle();
     void setStatusTextComponent(Text *t);
     void update(float dt);
+    // Layer components and scrolls are updated on the shared thread pool
+    void setThreading(bool threading);
     void updateReloadables(float dt);
+    TweenEngine& getTweenEngine();
     void cleanup();
-    void draw();
+    void draw(int monitor = -1); // -1 draws the components of every monitor
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
     void deInitializeFonts( ) const;
@@ -118,6 +123,8 @@ public:
     bool isSelectPlaying();
     std::string getCollectionName();
     CollectionInfo *getCollection();
+    std::vector<CollectionInfo *> getCollections() const;
+    void refreshItems();
     void  setMinShowTime(float value);
     float getMinShowTime() const;
     std::string controlsType() const;
@@ -132,7 +139,7 @@ public:
     void playlistNextExit();
     void playlistPrevEnter();
     void playlistPrevExit();
-    void triggerEventOnAllMenus(const std::string& event);
+    void triggerEventOnAllMenus(AnimationEvent event);
     void  menuJumpEnter();
     void  menuJumpExit();
     void  attractEnter( );
@@ -145,7 +152,7 @@ public:
     void buildInfoEnter();
     void buildInfoExit();
     void  jukeboxJump( );
-    void  triggerEvent( const std::string& action );
+    void  triggerEvent( AnimationEvent event );
     void  setText( const std::string& text, int id );
     void  addPlaylist();
     void  removePlaylist();
@@ -190,6 +197,7 @@ public:
 
 private:
     void playlistChange();
+    void updateInParallel(float dt);
     std::string lastPlaylistName_;
     std::string collectionName_;
     Configuration &config_;
@@ -218,6 +226,7 @@ private:
 
     static const unsigned int NUM_LAYERS = 20;
     std::vector<std::vector<Component*>> LayerComponents_; // Grouped by layer
+    std::vector<std::vector<Component*>> drawList_; // Visible components by layer, rebuilt by draw()
     std::list<ScrollingList *> deleteMenuList_;
     std::list<CollectionInfo *> deleteCollectionList_;
     std::map<std::string, size_t> lastPlaylistOffsets_;
@@ -240,6 +249,10 @@ private:
     std::vector<int> layoutHeightByMonitor_;
     bool jukebox_;
     bool useThreading_;
+    std::vector<Component*> parallelUpdates_;
+    std::vector<char> parallelDone_; // update results of parallelUpdates_
+    std::vector<Component*> removals_;
+    TweenEngine tweenEngine_;
     bool isLaunched_ = false;
 
 };
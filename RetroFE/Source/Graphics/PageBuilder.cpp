@@ -971,48 +971,18 @@ std::shared_ptr<AnimationEvents> PageBuilder::createTweenInstance(rapidxml::xml_
 {
 	auto tweens = std::make_shared<AnimationEvents>();
 
-	buildTweenSet(tweens.get(), componentXml, "onEnter", "enter");
-	buildTweenSet(tweens.get(), componentXml, "onExit", "exit");
-	buildTweenSet(tweens.get(), componentXml, "onIdle", "idle");
-	buildTweenSet(tweens.get(), componentXml, "onMenuIdle", "menuIdle");
-	buildTweenSet(tweens.get(), componentXml, "onMenuScroll", "menuScroll");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistScroll", "playlistScroll");
-	buildTweenSet(tweens.get(), componentXml, "onHighlightEnter", "highlightEnter");
-	buildTweenSet(tweens.get(), componentXml, "onHighlightExit", "highlightExit");
-	buildTweenSet(tweens.get(), componentXml, "onMenuEnter", "menuEnter");
-	buildTweenSet(tweens.get(), componentXml, "onMenuExit", "menuExit");
-	buildTweenSet(tweens.get(), componentXml, "onGameEnter", "gameEnter");
-	buildTweenSet(tweens.get(), componentXml, "onGameExit", "gameExit");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistEnter", "playlistEnter");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistExit", "playlistExit");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistNextEnter", "playlistNextEnter");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistNextExit", "playlistNextExit");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistPrevEnter", "playlistPrevEnter");
-	buildTweenSet(tweens.get(), componentXml, "onPlaylistPrevExit", "playlistPrevExit");
-	buildTweenSet(tweens.get(), componentXml, "onMenuJumpEnter", "menuJumpEnter");
-	buildTweenSet(tweens.get(), componentXml, "onMenuJumpExit", "menuJumpExit");
-	buildTweenSet(tweens.get(), componentXml, "onAttractEnter", "attractEnter");
-	buildTweenSet(tweens.get(), componentXml, "onAttract", "attract");
-	buildTweenSet(tweens.get(), componentXml, "onAttractExit", "attractExit");
-	buildTweenSet(tweens.get(), componentXml, "onJukeboxJump", "jukeboxJump");
-
-	buildTweenSet(tweens.get(), componentXml, "onGameInfoEnter", "gameInfoEnter");
-	buildTweenSet(tweens.get(), componentXml, "onGameInfoExit", "gameInfoExit");
-	buildTweenSet(tweens.get(), componentXml, "onCollectionInfoEnter", "collectionInfoEnter");
-	buildTweenSet(tweens.get(), componentXml, "onCollectionInfoExit", "collectionInfoExit");
-	buildTweenSet(tweens.get(), componentXml, "onBuildInfoEnter", "buildInfoEnter");
-	buildTweenSet(tweens.get(), componentXml, "onBuildInfoExit", "buildInfoExit");
-
-	buildTweenSet(tweens.get(), componentXml, "onMenuActionInputEnter", "menuActionInputEnter");
-	buildTweenSet(tweens.get(), componentXml, "onMenuActionInputExit", "menuActionInputExit");
-	buildTweenSet(tweens.get(), componentXml, "onMenuActionSelectEnter", "menuActionSelectEnter");
-	buildTweenSet(tweens.get(), componentXml, "onMenuActionSelectExit", "menuActionSelectExit");
+	// Every event is animated by its on<Event> tag, such as onMenuScroll
+	for (int event = 0; event < ANIMATION_EVENT_COUNT; ++event) {
+		std::string tagName = AnimationEvents::eventName(static_cast<AnimationEvent>(event));
+		tagName[0] = static_cast<char>(toupper(tagName[0]));
+		buildTweenSet(tweens.get(), componentXml, "on" + tagName, static_cast<AnimationEvent>(event));
+	}
 
 	return tweens;
 }
 
 
-void PageBuilder::buildTweenSet(AnimationEvents* tweens, xml_node<>* componentXml, const std::string& tagName, const std::string& tweenName) {
+void PageBuilder::buildTweenSet(AnimationEvents* tweens, xml_node<>* componentXml, const std::string& tagName, AnimationEvent event) {
 	for (componentXml = componentXml->first_node(tagName.c_str()); componentXml; componentXml = componentXml->next_sibling(tagName.c_str())) {
 		xml_attribute<> const* indexXml = componentXml->first_attribute("menuIndex");
 
@@ -1025,7 +995,7 @@ void PageBuilder::buildTweenSet(AnimationEvents* tweens, xml_node<>* componentXm
 					if (i != index) {
 						auto animation = std::make_shared<Animation>();
 						getTweenSet(componentXml, animation.get());
-						tweens->setAnimation(tweenName, i, std::move(animation));
+						tweens->setAnimation(event, i, std::move(animation));
 					}
 				}
 			}
@@ -1036,7 +1006,7 @@ void PageBuilder::buildTweenSet(AnimationEvents* tweens, xml_node<>* componentXm
 					if (i < index) {
 						auto animation = std::make_shared<Animation>();
 						getTweenSet(componentXml, animation.get());
-						tweens->setAnimation(tweenName, i, std::move(animation));
+						tweens->setAnimation(event, i, std::move(animation));
 					}
 				}
 			}
@@ -1047,26 +1017,26 @@ void PageBuilder::buildTweenSet(AnimationEvents* tweens, xml_node<>* componentXm
 					if (i > index) {
 						auto animation = std::make_shared<Animation>();
 						getTweenSet(componentXml, animation.get());
-						tweens->setAnimation(tweenName, i, std::move(animation));
+						tweens->setAnimation(event, i, std::move(animation));
 					}
 				}
 			}
 			else if (indexs[0] == 'i') {
 				auto animation = std::make_shared<Animation>();
 				getTweenSet(componentXml, animation.get());
-				tweens->setAnimation(tweenName, MENU_INDEX_HIGH, std::move(animation));
+				tweens->setAnimation(event, MENU_INDEX_HIGH, std::move(animation));
 			}
 			else {
 				int index = Utils::convertInt(indexXml->value());
 				auto animation = std::make_shared<Animation>();
 				getTweenSet(componentXml, animation.get());
-				tweens->setAnimation(tweenName, index, std::move(animation));
+				tweens->setAnimation(event, index, std::move(animation));
 			}
 		}
 		else {
 			auto animation = std::make_shared<Animation>();
 			getTweenSet(componentXml, animation.get());
-			tweens->setAnimation(tweenName, -1, std::move(animation));
+			tweens->setAnimation(event, -1, std::move(animation));
 		}
 	}
 }
@@ -1246,7 +1216,9 @@ void PageBuilder::buildCustomMenu(ScrollingList* menu, const rapidxml::xml_node<
 		viewInfo->Layout = menu->baseViewInfo.Layout;
 
 		buildViewInfo(componentXml, *viewInfo, itemDefaults);
-		viewInfo->Additive = menu->baseViewInfo.Additive;
+		ViewStyle style = viewInfo->style();
+		style.Additive = menu->baseViewInfo.style().Additive;
+		viewInfo->setStyle(style);
 
 		points->push_back(viewInfo);
 		tweenPoints->push_back(createTweenInstance(componentXml));
@@ -1474,10 +1446,11 @@ void PageBuilder::buildViewInfo(xml_node<>* componentXml, ViewInfo& info, xml_no
 	info.Alpha = alpha ? Utils::convertFloat(alpha->value()) : 1.f;
 	info.Angle = angle ? Utils::convertFloat(angle->value()) : 0.f;
 	info.Layer = layer ? Utils::convertInt(layer->value()) : 0;
-	info.Reflection = reflection ? reflection->value() : "";
-	info.ReflectionDistance = reflectionDistance ? Utils::convertInt(reflectionDistance->value()) : 0;
-	info.ReflectionScale = reflectionScale ? Utils::convertFloat(reflectionScale->value()) : 0.25f;
-	info.ReflectionAlpha = reflectionAlpha ? Utils::convertFloat(reflectionAlpha->value()) : 1.f;
+	ViewStyle style = info.style();
+	style.Reflection = reflection ? reflection->value() : "";
+	style.ReflectionDistance = reflectionDistance ? Utils::convertInt(reflectionDistance->value()) : 0;
+	style.ReflectionScale = reflectionScale ? Utils::convertFloat(reflectionScale->value()) : 0.25f;
+	style.ReflectionAlpha = reflectionAlpha ? Utils::convertFloat(reflectionAlpha->value()) : 1.f;
 	info.ContainerX = containerX ? Utils::convertFloat(containerX->value()) : 0.f;
 	info.ContainerY = containerY ? Utils::convertFloat(containerY->value()) : 0.f;
 	info.ContainerWidth = containerWidth ? Utils::convertFloat(containerWidth->value()) : -1.f;
@@ -1485,15 +1458,15 @@ void PageBuilder::buildViewInfo(xml_node<>* componentXml, ViewInfo& info, xml_no
 	info.Monitor = monitor ? Utils::convertInt(monitor->value()) : info.Monitor;
 	info.Volume = volume ? Utils::convertFloat(volume->value()) : 1.f;
 	info.Restart = restart ? Utils::toLower(restart->value()) == "true" : false;
-	info.Additive = additive ? Utils::toLower(additive->value()) == "true" : false;
+	style.Additive = additive ? Utils::toLower(additive->value()) == "true" : false;
 
 	if (pauseOnScroll) {
 		// If pauseOnScroll's value is "false", then set to false, otherwise true
-		info.PauseOnScroll = Utils::toLower(pauseOnScroll->value()) != "false";
+		style.PauseOnScroll = Utils::toLower(pauseOnScroll->value()) != "false";
 	}
 	else {
 		// If pauseOnScroll is null, default to true
-		info.PauseOnScroll = true;
+		style.PauseOnScroll = true;
 	}
 
 	// This reads the configuration and sets Restart or PauseOnScroll accordingly
@@ -1507,7 +1480,7 @@ void PageBuilder::buildViewInfo(xml_node<>* componentXml, ViewInfo& info, xml_no
 
 	// Check if the property exists and is set to true
 	if (config_.getProperty(OPTION_DISABLEPAUSEONSCROLL, disablePauseOnScroll) && disablePauseOnScroll) {
-		info.PauseOnScroll = false;
+		style.PauseOnScroll = false;
 	}
 
 	if (fontColor) {
@@ -1523,10 +1496,11 @@ void PageBuilder::buildViewInfo(xml_node<>* componentXml, ViewInfo& info, xml_no
 		int green = (num / 0x100) % 0x100;
 		int blue = num % 0x100;
 
-		info.BackgroundRed = static_cast<float>(red / 255);
-		info.BackgroundGreen = static_cast<float>(green / 255);
-		info.BackgroundBlue = static_cast<float>(blue / 255);
+		style.BackgroundRed = static_cast<float>(red / 255);
+		style.BackgroundGreen = static_cast<float>(green / 255);
+		style.BackgroundBlue = static_cast<float>(blue / 255);
 	}
+	info.setStyle(style);
 
 	if (backgroundAlpha) {
 		info.BackgroundAlpha = backgroundAlpha ? Utils::convertFloat(backgroundAlpha->value()) : 1.f;
@@ -1543,6 +1517,11 @@ void PageBuilder::getTweenSet(const xml_node<>* node, Animation* animation) {
 			// Use the shared_ptr to transfer ownership of the TweenSet instance to the Animation instance.
 			animation->Push(ts);
 		}
+		// Animations of several sets play as a timeline, laid out here unless
+		// their tweens differ by playlist
+		if (animation->size() > 1) {
+			animation->timeline(0);
+		}
 	}
 }
 
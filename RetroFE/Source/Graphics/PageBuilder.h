@@ -28,8 +28,6 @@
 #include <rapidxml.hpp>
 #include <vector>
 
-static const int MENU_INDEX_HIGH = 16;
-
 class ScrollingList;
 class Page;
 class ViewInfo;
@@ -42,6 +40,8 @@ public:
     PageBuilder(const std::string& layoutKey, const std::string& layoutPage, Configuration &c, FontCache *fc, bool isMenu = false);
     virtual ~PageBuilder();
     Page *buildPage( const std::string& collectionName = "", bool defaultToCurrentLayout = false);
+    // The animations of a layout component, scaled to the layout last built
+    std::shared_ptr<AnimationEvents> createTweenInstance(rapidxml::xml_node<>* componentXml);
 
 private:
     std::string layoutKey;
@@ -66,8 +66,7 @@ private:
     void buildViewInfo(rapidxml::xml_node<> *componentXml, ViewInfo &info, rapidxml::xml_node<> *defaultXml = nullptr);
     bool buildComponents(rapidxml::xml_node<> *layout, Page *page, const std::string&);
     void loadTweens(Component *c, rapidxml::xml_node<> *componentXml);
-    std::shared_ptr<AnimationEvents> createTweenInstance(rapidxml::xml_node<>* componentXml);
-    void buildTweenSet(AnimationEvents *tweens, rapidxml::xml_node<> *componentXml, const std::string& tagName, const std::string& tweenName);
+    void buildTweenSet(AnimationEvents *tweens, rapidxml::xml_node<> *componentXml, const std::string& tagName, AnimationEvent event);
     ScrollingList * buildMenu(rapidxml::xml_node<> *menuXml, Page &p, int monitor);
     void buildCustomMenu(ScrollingList *menu, const rapidxml::xml_node<> *menuXml, rapidxml::xml_node<> *itemDefaults);
     void buildVerticalMenu(ScrollingList *menu, const rapidxml::xml_node<> *menuXml, rapidxml::xml_node<> *itemDefaults);
@@ -0,0 +1,230 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TextureRegistry.h"
+#include "../Utility/Log.h"
+#include <cstdio>
+#include <limits>
+
+std::mutex                                   TextureRegistry::mutex_;
+std::unordered_map<SDL_Texture*, TextureRegistry::Entry> TextureRegistry::textures_;
+std::vector<std::array<uint64_t, TextureRegistry::OwnerCount>> TextureRegistry::bytes_;
+uint64_t                                     TextureRegistry::total_ = 0;
+uint64_t                                     TextureRegistry::budget_ = 0;
+bool                                         TextureRegistry::overBudget_ = false;
+std::vector<TextureRegistry::Evictor>        TextureRegistry::evictors_;
+
+namespace
+{
+    const char* ownerNames[] = { "images", "videos", "fonts", "targets" };
+
+    std::string megabytes(uint64_t bytes)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.1f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+        return buffer;
+    }
+}
+
+SDL_Texture* TextureRegistry::create(SDL_Renderer* renderer, Owner owner, int monitor, Uint32 format, int access, int width, int height)
+{
+    if (!renderer)
+        return nullptr;
+
+    reserve(textureBytes(format, width, height));
+    SDL_Texture* texture = SDL_CreateTexture(renderer, format, access, width, height);
+    if (!texture && evict(std::numeric_limits<uint64_t>::max()) > 0)
+        texture = SDL_CreateTexture(renderer, format, access, width, height);
+    if (!texture) {
+        LOG_ERROR("TextureRegistry", "Could not create a " + std::to_string(width) + "x" + std::to_string(height) +
+            " texture with " + usage() + " in use: " + std::string(SDL_GetError()));
+        return nullptr;
+    }
+    return add(texture, owner, monitor);
+}
+
+SDL_Texture* TextureRegistry::createFromSurface(SDL_Renderer* renderer, Owner owner, int monitor, SDL_Surface* surface)
+{
+    if (!renderer || !surface)
+        return nullptr;
+
+    // The texture format is picked by the renderer, most likely 32 bits
+    reserve(textureBytes(SDL_PIXELFORMAT_RGBA32, surface->w, surface->h));
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture && evict(std::numeric_limits<uint64_t>::max()) > 0)
+        texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        LOG_ERROR("TextureRegistry", "Could not create a " + std::to_string(surface->w) + "x" + std::to_string(surface->h) +
+            " texture with " + usage() + " in use: " + std::string(SDL_GetError()));
+        return nullptr;
+    }
+    return add(texture, owner, monitor);
+}
+
+SDL_Texture* TextureRegistry::add(SDL_Texture* texture, Owner owner, int monitor)
+{
+    if (!texture)
+        return nullptr;
+
+    Uint32 format = 0;
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(texture, &format, nullptr, &width, &height);
+    Entry entry{ owner, monitor < 0 ? 0 : monitor, textureBytes(format, width, height) };
+
+    bool crossedBudget = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // A destroyed texture's address may come back for a new one
+        auto it = textures_.find(texture);
+        if (it != textures_.end()) {
+            bytes_[it->second.monitor][it->second.owner] -= it->second.bytes;
+            total_ -= it->second.bytes;
+        }
+        textures_[texture] = entry;
+
+        if (bytes_.size() <= static_cast<size_t>(entry.monitor))
+            bytes_.resize(entry.monitor + 1, {});
+        bytes_[entry.monitor][entry.owner] += entry.bytes;
+        total_ += entry.bytes;
+
+        crossedBudget = budget_ && total_ > budget_ && !overBudget_;
+        overBudget_ = budget_ && total_ > budget_;
+    }
+
+    if (crossedBudget)
+        LOG_WARNING("TextureRegistry", "Over the texture budget of " + megabytes(budget_) + " with " + usage() + " in use");
+    return texture;
+}
+
+uint64_t TextureRegistry::destroy(SDL_Texture* texture)
+{
+    if (!texture)
+        return 0;
+
+    uint64_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = textures_.find(texture);
+        if (it != textures_.end()) {
+            bytes = it->second.bytes;
+            bytes_[it->second.monitor][it->second.owner] -= bytes;
+            total_ -= bytes;
+            textures_.erase(it);
+            overBudget_ = budget_ && total_ > budget_;
+        }
+    }
+    SDL_DestroyTexture(texture);
+    return bytes;
+}
+
+void TextureRegistry::setBudget(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = bytes;
+    overBudget_ = budget_ && total_ > budget_;
+}
+
+void TextureRegistry::addEvictor(Evictor evictor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    evictors_.push_back(std::move(evictor));
+}
+
+uint64_t TextureRegistry::getBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+}
+
+uint64_t TextureRegistry::getBytes(Owner owner, int monitor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+        if (monitor < 0 || static_cast<size_t>(monitor) == i)
+            bytes += bytes_[i][owner];
+    }
+    return bytes;
+}
+
+void TextureRegistry::logUsage(const std::string& reason)
+{
+    LOG_INFO("TextureRegistry", reason + ": " + usage());
+}
+
+// Planar YUV has a full size luma plane and quarter size chroma planes
+uint64_t TextureRegistry::textureBytes(Uint32 format, int width, int height)
+{
+    uint64_t pixels = static_cast<uint64_t>(width > 0 ? width : 0) * static_cast<uint64_t>(height > 0 ? height : 0);
+    if (format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_IYUV ||
+        format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21)
+        return pixels * 3 / 2;
+    return pixels * (SDL_BYTESPERPIXEL(format) ? SDL_BYTESPERPIXEL(format) : 4);
+}
+
+// Make room for a new texture before the driver has to
+void TextureRegistry::reserve(uint64_t bytes)
+{
+    uint64_t excess = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!budget_ || total_ + bytes <= budget_)
+            return;
+        excess = total_ + bytes - budget_;
+    }
+    evict(excess);
+}
+
+uint64_t TextureRegistry::evict(uint64_t bytes)
+{
+    std::vector<Evictor> evictors;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        evictors = evictors_;
+    }
+
+    uint64_t freed = 0;
+    for (const Evictor& evictor : evictors) {
+        if (freed >= bytes)
+            break;
+        freed += evictor(bytes - freed);
+    }
+    if (freed > 0)
+        LOG_INFO("TextureRegistry", "Evicted " + megabytes(freed) + " of unused textures, " + usage() + " in use");
+    return freed;
+}
+
+std::string TextureRegistry::usage()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string text = megabytes(total_) + " in " + std::to_string(textures_.size()) + " textures (";
+    for (int owner = 0; owner < OwnerCount; ++owner) {
+        uint64_t bytes = 0;
+        for (const auto& monitor : bytes_)
+            bytes += monitor[owner];
+        text += std::string(owner ? ", " : "") + ownerNames[owner] + " " + megabytes(bytes);
+    }
+    text += ")";
+    if (bytes_.size() > 1) {
+        for (size_t monitor = 0; monitor < bytes_.size(); ++monitor) {
+            uint64_t bytes = 0;
+            for (uint64_t ownerBytes : bytes_[monitor])
+                bytes += ownerBytes;
+            text += ", monitor " + std::to_string(monitor) + " " + megabytes(bytes);
+        }
+    }
+    return text;
+}
@@ -0,0 +1,80 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Accounts the memory of every texture RetroFE creates, by owner and monitor.
+//
+// With a budget, textures that would go over it first ask the evictors to
+// drop textures nobody draws, such as cached artwork. A creation the driver
+// fails is retried once after evicting everything evictable.
+class TextureRegistry
+{
+public:
+    enum Owner
+    {
+        OwnerImage,
+        OwnerVideo,
+        OwnerFont,
+        OwnerTarget,
+        OwnerCount
+    };
+
+    // Frees textures that are not in use, returns the bytes it released
+    using Evictor = std::function<uint64_t(uint64_t bytes)>;
+
+    static SDL_Texture* create(SDL_Renderer* renderer, Owner owner, int monitor, Uint32 format, int access, int width, int height);
+    static SDL_Texture* createFromSurface(SDL_Renderer* renderer, Owner owner, int monitor, SDL_Surface* surface);
+    // Accounts a texture created elsewhere, without making room for it first
+    static SDL_Texture* add(SDL_Texture* texture, Owner owner, int monitor);
+    // Returns the bytes the texture was accounted with
+    static uint64_t destroy(SDL_Texture* texture);
+
+    static void setBudget(uint64_t bytes);
+    static void addEvictor(Evictor evictor);
+    static uint64_t getBytes();
+    static uint64_t getBytes(Owner owner, int monitor = -1);
+    static void logUsage(const std::string& reason);
+
+private:
+    struct Entry
+    {
+        Owner    owner;
+        int      monitor;
+        uint64_t bytes;
+    };
+
+    static uint64_t textureBytes(Uint32 format, int width, int height);
+    static void reserve(uint64_t bytes);
+    static uint64_t evict(uint64_t bytes);
+    static std::string usage();
+
+    static std::mutex                                   mutex_;
+    static std::unordered_map<SDL_Texture*, Entry>      textures_;
+    static std::vector<std::array<uint64_t, OwnerCount>> bytes_; // per monitor
+    static uint64_t                                     total_;
+    static uint64_t                                     budget_;
+    static bool                                         overBudget_;
+    static std::vector<Evictor>                         evictors_;
+};
@@ -1,36 +1,128 @@
 #include "ThreadPool.h"
+#include "../Utility/Log.h"
+#include <algorithm>
+
+thread_local ThreadPool* ThreadPool::currentPool_ = nullptr;
+thread_local size_t ThreadPool::currentWorker_ = 0;
+
+ThreadPool::Task::Task(Task&& other) noexcept : ops_(other.ops_) {
+    if (ops_) {
+        ops_->move(other.storage_, storage_);
+        other.ops_ = nullptr;
+    }
+}
+
+ThreadPool::Task& ThreadPool::Task::operator=(Task&& other) noexcept {
+    if (this != &other) {
+        if (ops_) {
+            ops_->destroy(storage_);
+        }
+        ops_ = other.ops_;
+        if (ops_) {
+            ops_->move(other.storage_, storage_);
+            other.ops_ = nullptr;
+        }
+    }
+    return *this;
+}
+
+ThreadPool::Task::~Task() {
+    if (ops_) {
+        ops_->destroy(storage_);
+    }
+}
 
 // Constructor
-ThreadPool::ThreadPool(size_t threads) : stop(false) {
+ThreadPool::ThreadPool(size_t threads) {
+    threads = std::max<size_t>(threads, 1);
     for (size_t i = 0; i < threads; ++i)
-        workers.emplace_back(
-            [this] {
-                for (;;) {
-                    std::function<void()> task; {
-                        std::unique_lock<std::mutex> lock(this->queueMutex);
-                        this->condition.wait(lock,
-                            [this] { return this->stop || !this->tasks.empty(); });
-
-                        if (this->stop && this->tasks.empty())
-                            return;
-
-                        task = std::move(this->tasks.front());
-                        this->tasks.pop();
-                    }
-
-                    task();
-                }
-            }
-    );
+        workers_.push_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < threads; ++i)
+        threads_.emplace_back([this, i] { run(i); });
 }
 
-// Destructor joins all threads
+// Destructor runs what is still queued and joins all threads
 ThreadPool::~ThreadPool() {
     {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        stop = true;
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_)
+        thread.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::max<size_t>(std::thread::hardware_concurrency(), 4));
+    return pool;
+}
+
+void ThreadPool::push(Task task, Priority priority) {
+    size_t index = currentPool_ == this ? currentWorker_ : nextWorker_++ % workers_.size();
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (stop_)
+            throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+    {
+        std::unique_lock<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->queues[priority].push_back(std::move(task));
+    }
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        ++pending_;
+    }
+    wake_.notify_one();
+}
+
+// A worker takes its newest task, from others it takes their oldest
+bool ThreadPool::take(size_t index, Task& task) {
+    for (int priority = 0; priority < PriorityCount; ++priority) {
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            Worker& worker = *workers_[(index + i) % workers_.size()];
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            std::deque<Task>& queue = worker.queues[priority];
+            if (queue.empty())
+                continue;
+            if (i == 0) {
+                task = std::move(queue.back());
+                queue.pop_back();
+            }
+            else {
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t index) {
+    currentPool_ = this;
+    currentWorker_ = index;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+            if (pending_ == 0)
+                return;
+            // Claims one of the queued tasks, whichever queue it ends up in
+            --pending_;
+        }
+
+        Task task;
+        while (!take(index, task))
+            std::this_thread::yield();
+
+        try {
+            task();
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("ThreadPool", std::string("Task failed: ") + e.what());
+        }
+        catch (...) {
+            LOG_ERROR("ThreadPool", "Task failed with an unknown exception");
+        }
     }
-    condition.notify_all();
-    for (std::thread& worker : workers)
-        worker.join();
 }
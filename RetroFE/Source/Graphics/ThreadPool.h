@@ -2,18 +2,67 @@
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
-#include <vector>
-#include <queue>
-#include <thread>
-#include <mutex>
+#include <atomic>
 #include <condition_variable>
-#include <future>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <thread>
 #include <type_traits> // Include for std::invoke_result
+#include <utility>
+#include <vector>
 
+// Runs tasks on a fixed set of threads.
+//
+// Every worker has its own queues, one per priority. Tasks queued from a
+// worker stay on it, others are spread over the workers in turn. A worker
+// that runs out takes from the others, always the most urgent task first.
 class ThreadPool {
 public:
+    enum Priority {
+        PriorityFrame,      // the current frame waits for it
+        PriorityPrefetch,   // needed soon, such as the artwork of the next items
+        PriorityBackground, // file and process work nobody waits for
+        PriorityCount
+    };
+
+    // A callable that is stored in place when it fits, as lambdas capturing a
+    // few values do, so queuing it does not allocate
+    class Task {
+    public:
+        Task() = default;
+        template<class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f);
+        Task(Task&& other) noexcept;
+        Task& operator=(Task&& other) noexcept;
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task();
+
+        void operator()() { ops_->invoke(storage_); }
+        explicit operator bool() const { return ops_ != nullptr; }
+
+    private:
+        static constexpr size_t inlineSize = 64;
+
+        struct Ops {
+            void (*invoke)(void* storage);
+            void (*move)(void* from, void* to);
+            void (*destroy)(void* storage);
+        };
+
+        template<class F> static const Ops* inlineOps();
+        template<class F> static const Ops* heapOps();
+
+        alignas(std::max_align_t) unsigned char storage_[inlineSize];
+        const Ops* ops_ = nullptr;
+    };
+
     explicit ThreadPool(size_t threads);
     ~ThreadPool();
 
@@ -21,40 +70,105 @@ public:
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args)
         -> std::future<typename std::invoke_result_t<F, Args...>>;
+    template<class F, class... Args>
+    auto enqueue(Priority priority, F&& f, Args&&... args)
+        -> std::future<typename std::invoke_result_t<F, Args...>>;
+
+    // Runs the task without anything to wait on, exceptions are logged
+    template<class F>
+    void post(F&& f, Priority priority = PriorityBackground);
+
+    size_t size() const { return workers_.size(); }
+
+    // The pool shared by the page updates and the background work
+    static ThreadPool& shared();
 
 private:
-    // Worker threads
-    std::vector<std::thread> workers;
-    // Task queue
-    std::queue<std::function<void()>> tasks;
-
-    // Synchronization
-    std::mutex queueMutex;
-    std::condition_variable condition;
-    bool stop;
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> queues[PriorityCount];
+    };
+
+    void push(Task task, Priority priority);
+    bool take(size_t index, Task& task);
+    void run(size_t index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> nextWorker_{ 0 };
+
+    // Workers sleep while no task is queued anywhere
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    size_t pending_ = 0;
+    bool stop_ = false;
+
+    static thread_local ThreadPool* currentPool_;
+    static thread_local size_t currentWorker_;
 };
 
+template<class F, class>
+ThreadPool::Task::Task(F&& f) {
+    using Callable = std::decay_t<F>;
+    if constexpr (sizeof(Callable) <= inlineSize && alignof(Callable) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Callable>) {
+        new (storage_) Callable(std::forward<F>(f));
+        ops_ = inlineOps<Callable>();
+    }
+    else {
+        new (storage_) Callable*(new Callable(std::forward<F>(f)));
+        ops_ = heapOps<Callable>();
+    }
+}
+
+template<class F>
+const ThreadPool::Task::Ops* ThreadPool::Task::inlineOps() {
+    static constexpr Ops ops = {
+        [](void* storage) { (*static_cast<F*>(storage))(); },
+        [](void* from, void* to) {
+            new (to) F(std::move(*static_cast<F*>(from)));
+            static_cast<F*>(from)->~F();
+        },
+        [](void* storage) { static_cast<F*>(storage)->~F(); }
+    };
+    return &ops;
+}
+
+template<class F>
+const ThreadPool::Task::Ops* ThreadPool::Task::heapOps() {
+    static constexpr Ops ops = {
+        [](void* storage) { (**static_cast<F**>(storage))(); },
+        [](void* from, void* to) { new (to) F*(*static_cast<F**>(from)); },
+        [](void* storage) { delete *static_cast<F**>(storage); }
+    };
+    return &ops;
+}
+
 // Implementation of the enqueue method needs to be visible to all translation units that use it, hence defined in the header
 template<class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args)
+-> std::future<typename std::invoke_result_t<F, Args...>> {
+    return enqueue(PriorityFrame, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<class F, class... Args>
+auto ThreadPool::enqueue(Priority priority, F&& f, Args&&... args)
 -> std::future<typename std::invoke_result_t<F, Args...>> {
     using return_type = typename std::invoke_result<F, Args...>::type;
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
+    // The task is moved into the queue, only its shared state is allocated
+    std::packaged_task<return_type()> task(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...)
     );
 
-    std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queueMutex);
-
-        if (stop)
-            throw std::runtime_error("enqueue on stopped ThreadPool");
-
-        tasks.emplace([task] { (*task)(); });
-    }
-    condition.notify_one();
+    std::future<return_type> res = task.get_future();
+    push(Task(std::move(task)), priority);
     return res;
 }
 
+template<class F>
+void ThreadPool::post(F&& f, Priority priority) {
+    push(Task(std::forward<F>(f)), priority);
+}
+
 #endif // THREADPOOL_H
@@ -17,13 +17,51 @@
 #include "ViewInfo.h"
 #include "../Database/Configuration.h"
 #include "Animate/TweenTypes.h"
+#include <deque>
+#include <mutex>
+#include <type_traits>
 
-ViewInfo::ViewInfo()
+static_assert(std::is_trivially_copyable_v<ViewInfo>, "ViewInfo is copied for every animation and scroll");
+
+bool ViewStyle::operator==(const ViewStyle& other) const
+{
+    return Reflection == other.Reflection && ReflectionDistance == other.ReflectionDistance &&
+        ReflectionScale == other.ReflectionScale && ReflectionAlpha == other.ReflectionAlpha &&
+        BackgroundRed == other.BackgroundRed && BackgroundGreen == other.BackgroundGreen &&
+        BackgroundBlue == other.BackgroundBlue && Additive == other.Additive && PauseOnScroll == other.PauseOnScroll;
+}
+
+void ViewInfo::setStyle(const ViewStyle& style)
 {
+    style_ = intern(style);
 }
 
+// Only the layout loaders add styles, and a deque never moves what it holds
+const ViewStyle* ViewInfo::intern(const ViewStyle& style)
+{
+    static std::mutex mutex;
+    static std::deque<ViewStyle> styles;
 
-ViewInfo::~ViewInfo() = default;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const ViewStyle& existing : styles) {
+        if (existing == style) {
+            return &existing;
+        }
+    }
+    styles.push_back(style);
+    return &styles.back();
+}
+
+const ViewStyle* ViewInfo::defaultStyle(bool additive)
+{
+    static const ViewStyle* style = intern(ViewStyle());
+    static const ViewStyle* additiveStyle = [] {
+        ViewStyle s;
+        s.Additive = true;
+        return intern(s);
+    }();
+    return additive ? additiveStyle : style;
+}
 
 float ViewInfo::XRelativeToOrigin() const
 {
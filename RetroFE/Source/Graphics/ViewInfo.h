@@ -22,13 +22,29 @@
 
 class FontManager;
 
+// What the layout sets once and only drawing looks at. Views with the same
+// style share a single copy.
+struct ViewStyle
+{
+    std::string  Reflection{ "" };
+    unsigned int ReflectionDistance{ 0 };
+    float        ReflectionScale{ .25 };
+    float        ReflectionAlpha{ 1 };
+    float        BackgroundRed{ 0 };
+    float        BackgroundGreen{ 0 };
+    float        BackgroundBlue{ 0 };
+    bool         Additive{ false };
+    bool         PauseOnScroll{ true };
+
+    bool operator==(const ViewStyle& other) const;
+};
+
+// Where and how a component is drawn. Tweens, scrolling and drawing work on
+// the values here; the style is only referenced, so a copy is plain memory.
 class ViewInfo
 {
 public:
 
-    ViewInfo();
-    virtual ~ViewInfo();
-
     float XRelativeToOrigin() const;
     float YRelativeToOrigin() const;
 
@@ -41,6 +57,13 @@ public:
     static const int AlignRight = -4;
     static const int AlignBottom = -5;
 
+    const ViewStyle& style() const { return *style_; }
+    // Styles are kept for good, there are only as many as the layouts define
+    void setStyle(const ViewStyle& style);
+    // The default style, the additive one is kept aside so components created
+    // while scrolling do not intern
+    void resetStyle(bool additive = false) { style_ = defaultStyle(additive); }
+
     float        X{ 0 };
     float        Y{ 0 };
     float        XOrigin{ 0 };
@@ -56,30 +79,25 @@ public:
     float        ImageWidth{ 0 };
     float        ImageHeight{ 0 };
     float        FontSize{ -1 };
-    FontManager* font{ nullptr };
     float        Angle{ 0 };
     float        Alpha{ 1 };
-    unsigned int Layer{ 0 };
-    unsigned int Layout{ 0 };
-    float        BackgroundRed{ 0 };
-    float        BackgroundGreen{ 0 };
-    float        BackgroundBlue{ 0 };
     float        BackgroundAlpha{ 0 };
-    std::string  Reflection{ "" };
-    unsigned int ReflectionDistance{ 0 };
-    float        ReflectionScale{ .25 };
-    float        ReflectionAlpha{ 1 };
     float        ContainerX{ 0 };
     float        ContainerY{ 0 };
     float        ContainerWidth{ -1 };
     float        ContainerHeight{ -1 };
-    int          Monitor{ 0 };
     float        Volume{ 0 };
+    unsigned int Layer{ 0 };
+    unsigned int Layout{ 0 };
+    int          Monitor{ 0 };
     bool         Restart{ false };
-    bool         Additive{ false };
-    bool         PauseOnScroll{ true };
+    FontManager* font{ nullptr };
 
 private:
+    static const ViewStyle* intern(const ViewStyle& style);
+    static const ViewStyle* defaultStyle(bool additive = false);
     float AbsoluteHeight() const;
     float AbsoluteWidth() const;
+
+    const ViewStyle* style_{ defaultStyle() };
 };
@@ -181,6 +181,24 @@ int main(int argc, char** argv)
             metadb->resetDatabase();
             return 0;
         }
+        else if (param == "-exportsnapshot" ||
+            param == "--exportsnapshot" ||
+            param == "-es") {
+            // Write meta.snapshot from the current database for use with metaLock
+            DB* db = nullptr;
+            MetadataDatabase* metadb = nullptr;
+            if (!initializeDB(db, dbPath)) {
+                return 0;
+            }
+            if (!initializeMetadataDatabase(metadb, db, config)) {
+                delete db;
+                return 0;
+            }
+            metadb->exportSnapshot();
+            delete metadb;
+            delete db;
+            return 0;
+        }
         else if (param == "-gstdotdebug" ||
             param == "--gstdotdebug") {
             Utils::setEnvVar("GST_DEBUG_DUMP_DOT_DIR", Configuration::absolutePath);
@@ -290,6 +308,7 @@ int main(int argc, char** argv)
             std::cout << std::endl;
             std::cout << "  -cc  -createcollection   Create a collection directory structure        [collectionName] {local}" << std::endl;
             std::cout << "  -rdb -rebuilddatabase    Rebuild the database from /meta subfolder" << std::endl;
+            std::cout << "  -es  -exportsnapshot     Write meta.snapshot, used instead of meta.db when metaLock is set" << std::endl;
             std::cout << "  -su  -showusage          Print a list of all global settings" << std::endl;
             std::cout << "  -sc  -showconfig         Print a list of current settings" << std::endl;
             std::cout << "  -C   -createconfig       Create a settings.conf with default values and a readme" << std::endl;
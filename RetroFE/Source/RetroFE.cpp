@@ -24,11 +24,15 @@
 #include "Database/GlobalOpts.h"
 #include "Database/HiScores.h"
 #include "Execute/Launcher.h"
+#include "Graphics/Animate/Easing.h"
+#include "Graphics/Component/Image.h"
 #include "Graphics/Component/ScrollingList.h"
 #include "Graphics/Page.h"
 #include "Graphics/PageBuilder.h"
+#include "Graphics/TextureRegistry.h"
 #include "Menu/Menu.h"
 #include "SDL.h"
+#include "Utility/FramePacer.h"
 #include "Utility/Log.h"
 #include "Utility/Utils.h"
 #include "Video/VideoFactory.h"
@@ -112,41 +116,24 @@ RetroFE::~RetroFE()
 	deInitialize();
 }
 
-// Render the current page to the screen
-void RetroFE::render()
+// Render the current page to the screen, returns false if no screen changed
+bool RetroFE::render()
 {
 	SDL_LockMutex(SDL::getMutex());
+	SDL::updateTransforms();
 
-	// Step 1: Set the render target to the texture and clear each screen's texture
-	for (int i = 0; i < SDL::getScreenCount(); ++i)
-	{
-		// Set the render target to the corresponding texture
-		SDL_SetRenderTarget(SDL::getRenderer(i), SDL::getRenderTarget(i));
-		SDL_SetRenderDrawColor(SDL::getRenderer(i), 0x0, 0x0, 0x0, 0xFF);
-		SDL_RenderClear(SDL::getRenderer(i));
-
-	}
-
-	// Step 2: Draw the current page onto the render target (textures)
+	// Step 1: Record the copies of the current page
+	SDL::beginFrame();
 	if (currentPage_)
 	{
-		currentPage_->draw();  // Draws onto the currently set render targets (textures)
+		currentPage_->draw();
 	}
 
-	// Step 3: Present the rendered content on each screen
-	for (int i = 0; i < SDL::getScreenCount(); ++i)
-	{
-		// Switch back to the screen's framebuffer
-		SDL_SetRenderTarget(SDL::getRenderer(i), nullptr);
-
-		// Render the texture onto the screen
-		SDL_RenderCopy(SDL::getRenderer(i), SDL::getRenderTarget(i), nullptr, nullptr);
-
-		// Present the final result to the screen
-		SDL_RenderPresent(SDL::getRenderer(i));
-	}
+	// Step 2: Draw and present the screens whose contents changed
+	bool presented = SDL::endFrames();
 
 	SDL_UnlockMutex(SDL::getMutex());
+	return presented;
 }
 
 // Initialize the configuration and database
@@ -173,7 +160,11 @@ int RetroFE::initialize(void* context)
 	}
 	instance->metadb_ = new MetadataDatabase(*(instance->db_), instance->config_);
 
-	if (!instance->metadb_->initialize())
+	// Changed XMLs can be imported once the frontend is up instead of holding the splash screen
+	bool backgroundMetaImport = true;
+	instance->config_.getProperty(OPTION_BACKGROUNDMETAIMPORT, backgroundMetaImport);
+
+	if (!instance->metadb_->initialize(backgroundMetaImport))
 	{
 		LOG_ERROR("RetroFE", "Could not initialize meta database");
 		instance->initializeError = true;
@@ -229,6 +220,7 @@ void RetroFE::launchExit()
 	SDL_RestoreWindow(SDL::getWindow(0));
 	SDL_RaiseWindow(SDL::getWindow(0));
 	SDL_SetWindowGrab(SDL::getWindow(0), SDL_TRUE);
+	SDL::invalidate();
 
 	// Empty event queue, but handle joystick add/remove events
 	SDL_Event e;
@@ -396,6 +388,7 @@ bool RetroFE::run()
 		return false;
 	if (!fontcache_.initialize())
 		return false;
+	TextureRegistry::addEvictor(Image::evictTextureCache);
 	SDL_RestoreWindow(SDL::getWindow(0));
 	SDL_RaiseWindow(SDL::getWindow(0));
 	SDL_SetWindowGrab(SDL::getWindow(0), SDL_TRUE);
@@ -453,6 +446,10 @@ bool RetroFE::run()
 	VideoFactory::setEnabled(videoEnable);
 	VideoFactory::setNumLoops(videoLoop);
 
+	bool easingTables = false;
+	config_.getProperty(OPTION_EASINGTABLES, easingTables);
+	Easing::setTables(easingTables);
+
 	initializeThread = SDL_CreateThread(initialize, "RetroFEInit", (void*)this);
 
 	if (!initializeThread)
@@ -502,10 +499,18 @@ bool RetroFE::run()
 	int fpsIdle = 60;
 	config_.getProperty(OPTION_FPS, fps);
 	config_.getProperty(OPTION_FPSIDLE, fpsIdle);
-	double fpsTime = 1000.0 / static_cast<double>(fps);
-	double fpsIdleTime = 1000.0 / static_cast<double>(fpsIdle);
 	bool vSync = false;
 	config_.getProperty(OPTION_VSYNC, vSync);
+	SDL_DisplayMode displayMode;
+	int refreshRate = 0;
+	if (SDL_GetWindowDisplayMode(SDL::getWindow(0), &displayMode) == 0)
+	{
+		refreshRate = displayMode.refresh_rate;
+	}
+	FramePacer pacer(fps, fpsIdle, vSync, refreshRate);
+	LOG_INFO("RetroFE", "Frame pacing at " + std::to_string(fps) + " fps, " + std::to_string(fpsIdle) + " fps idle, display refresh " +
+		std::to_string(static_cast<int>(pacer.refreshRate() + 0.5)) + " Hz");
+	bool presented = true;
 
 	int initializeStatus = 0;
 	bool inputClear = false;
@@ -551,7 +556,6 @@ bool RetroFE::run()
 		config_.setProperty("quickListPlaylist", quickListPlaylist);
 	}
 
-	float lastTime = 0;
 	float deltaTime = 0;
 	float inputUpdateInterval = 0.0333f; // Update every ~33.33ms (~30Hz)
 	static float lastInputUpdateTime = 0.0f;
@@ -602,6 +606,11 @@ bool RetroFE::run()
 
 			currentPage_->cleanup();
 
+			if (!splashMode && currentPage_->isIdle())
+			{
+				refreshImportedMetadata();
+			}
+
 			// Not in splash mode
 			if (currentPage_ && !splashMode)
 			{
@@ -628,6 +637,7 @@ bool RetroFE::run()
 					state = RETROFE_QUIT_REQUEST;
 					break;
 				}
+				metadb_->startBackgroundImport();
 				currentPage_->stop();
 				state = RETROFE_SPLASH_EXIT;
 			}
@@ -650,6 +660,10 @@ bool RetroFE::run()
 				bool startCollectionEnter = false;
 				config_.getProperty(OPTION_STARTCOLLECTIONENTER, startCollectionEnter);
 				nextPageItem_ = currentPage_->getSelectedItem();
+				if (!splashMode)
+				{
+					TextureRegistry::logUsage("Texture memory after entering " + currentPage_->getCollectionName());
+				}
 				if (!splashMode && startCollectionEnter && !nextPageItem_->leaf)
 				{
 					state = RETROFE_NEXT_PAGE_REQUEST;
@@ -1479,6 +1493,7 @@ bool RetroFE::run()
 						input_.update(e);
 					input_.resetStates();
 				}
+				TextureRegistry::logUsage("Texture memory after entering " + currentPage_->getCollectionName());
 				state = RETROFE_IDLE;
 			}
 			break;
@@ -2262,27 +2277,10 @@ bool RetroFE::run()
 		// Handle screen updates and attract mode
 		if (running)
 		{
-			lastTime = currentTime_;
-			currentTime_ = static_cast<float>(SDL_GetTicks()) / 1000;
-
-			if (currentTime_ < lastTime)
-			{
-				currentTime_ = lastTime;
-			}
-
-			deltaTime = currentTime_ - lastTime;
-			double sleepTime;
-			if (state == RETROFE_IDLE)
-				sleepTime = fpsIdleTime - deltaTime * 1000;
-			else
-				sleepTime = fpsTime - deltaTime * 1000;
-			if (sleepTime > 0 && sleepTime < 1000)
-			{
-				if (vSync == false)
-				{
-					SDL_Delay(static_cast<unsigned int>(sleepTime));
-				}
-			}
+			// Anything but a settled page runs at the full frame rate
+			bool active = state != RETROFE_IDLE || (currentPage_ && !currentPage_->isIdle());
+			deltaTime = pacer.nextFrame(active, presented);
+			currentTime_ = std::max(currentTime_, static_cast<float>(SDL_GetTicks()) / 1000);
 
 			if (currentPage_)
 			{
@@ -2328,7 +2326,13 @@ bool RetroFE::run()
 				{
 					attract_.reset();
 				}
-				currentPage_->update(deltaTime);
+				// Semi-fixed timestep, a long frame is updated in several steps
+				for (float remaining = deltaTime; remaining > 0;)
+				{
+					float step = std::min(remaining, pacer.maxStep());
+					currentPage_->update(step);
+					remaining -= step;
+				}
 				SDL_PumpEvents();
 				// Update keystate at 30Hz
 				if (currentTime_ - lastInputUpdateTime >= inputUpdateInterval)
@@ -2367,7 +2371,7 @@ bool RetroFE::run()
 				}
 			}
 
-			render();
+			presented = render();
 		}
 	}
 	return reboot_;
@@ -3351,7 +3355,14 @@ CollectionInfo* RetroFE::getCollection(const std::string& collectionName)
 		item->loadInfo(path);
 	}
 
-	// Remove parenthesis and brackets, if so configured
+	applyTitleOptions(collection);
+
+	return collection;
+}
+
+// Remove parenthesis and brackets from titles, if so configured
+void RetroFE::applyTitleOptions(CollectionInfo* collection)
+{
 	bool showParenthesis = true;
 	bool showSquareBrackets = true;
 
@@ -3397,8 +3408,75 @@ CollectionInfo* RetroFE::getCollection(const std::string& collectionName)
 			}
 		}
 	}
+}
 
-	return collection;
+// Re-inject and re-sort loaded collections whose metadata finished importing
+// in the background since the last call
+void RetroFE::refreshImportedMetadata()
+{
+	std::vector<std::string> imported;
+	if (!metadb_ || !currentPage_ || !metadb_->takeImported(imported))
+	{
+		return;
+	}
+
+	// An empty name means the list did not map to a single collection
+	bool refreshAll = std::find(imported.begin(), imported.end(), "") != imported.end();
+	bool refreshed = false;
+
+	for (CollectionInfo* collection : currentPage_->getCollections())
+	{
+		// Merged subcollections keep their own metadata type
+		std::vector<CollectionInfo*> sources = { collection };
+		for (Item const* item : collection->items)
+		{
+			if (item->collectionInfo && std::find(sources.begin(), sources.end(), item->collectionInfo) == sources.end())
+			{
+				sources.push_back(item->collectionInfo);
+			}
+		}
+
+		bool injected = false;
+		for (CollectionInfo* source : sources)
+		{
+			if (!refreshAll && std::find(imported.begin(), imported.end(), source->metadataType) == imported.end())
+			{
+				continue;
+			}
+			// Only the source's own games, as at startup: menu entries never got
+			// metadata and a name clash must not hide the collection's own item
+			std::vector<Item*> items;
+			for (Item* item : collection->items)
+			{
+				if (item->leaf && item->collectionInfo == source)
+				{
+					items.push_back(item);
+				}
+			}
+			metadb_->injectMetadata(source->metadataType, items);
+			injected = true;
+		}
+		if (!injected)
+		{
+			continue;
+		}
+
+		LOG_INFO("RetroFE", "Refreshing metadata for " + collection->name);
+		bool menuSort = true;
+		config_.getProperty("collections." + collection->name + ".list.menuSort", menuSort);
+		if (menuSort)
+		{
+			collection->sortItems();
+		}
+		collection->sortPlaylists();
+		applyTitleOptions(collection);
+		refreshed = true;
+	}
+
+	if (refreshed)
+	{
+		currentPage_->refreshItems();
+	}
 }
 
 void RetroFE::updatePageControls(const std::string& type)
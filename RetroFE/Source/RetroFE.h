@@ -150,7 +150,7 @@ private:
         RETROFE_SCROLL_PLAYLIST_BACK,
     };
 
-    void            render();
+    bool            render();
     bool            back( bool &exit );
     bool isStandalonePlaylist(std::string playlist);
     bool isInAttractModeSkipPlaylist(std::string playlist);
@@ -167,6 +167,8 @@ private:
     CollectionInfo *getCollection( const std::string& collectionName );
     void updatePageControls(const std::string& type);
     CollectionInfo *getMenuCollection( const std::string& collectionName );
+    void applyTitleOptions(CollectionInfo* collection);
+    void refreshImportedMetadata();
 	void            saveRetroFEState( ) const;
     std::string getLayoutFileName();
     void resetInfoToggle();
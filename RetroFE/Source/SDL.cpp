@@ -27,6 +27,11 @@
 #error "Cannot find SDL_mixer header"
 #endif
 #include "Utility/Utils.h"
+#include "Graphics/TextureRegistry.h"
+#include "Graphics/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 std::vector<SDL_Window*>   SDL::window_;
 std::vector<SDL_Renderer*> SDL::renderer_;
@@ -42,6 +47,41 @@ std::vector<bool>           SDL::mirror_;
 int                         SDL::numScreens_ = 1;
 int                         SDL::numDisplays_ = 1;
 int                         SDL::screenCount_;
+std::vector<SDL::ScreenTransform> SDL::transforms_;
+std::vector<SDL::ScreenFrame> SDL::frames_;
+std::vector<std::unique_ptr<ThreadPool>> SDL::renderThreads_;
+std::atomic<bool>           SDL::renderBatching_{ true };
+bool                        SDL::skipIdleFrames_ = true;
+bool                        SDL::directRender_ = false;
+std::atomic<unsigned int>   SDL::generation_{ 0 };
+std::atomic<unsigned int>   SDL::resets_{ 0 };
+std::atomic<bool>           SDL::layerCache_{ true };
+SDL_BlendMode               SDL::premultipliedBlend_ = SDL_BLENDMODE_INVALID;
+unsigned int                SDL::layer_ = 0;
+std::mutex                  SDL::dirtyMutex_;
+std::vector<SDL_Texture*>   SDL::dirtyTextures_;
+std::vector<SDL_Texture*>   SDL::frameDirtyTextures_;
+std::atomic<uint64_t>       SDL::statCopies_{ 0 };
+std::atomic<uint64_t>       SDL::statDrawCalls_{ 0 };
+std::atomic<uint64_t>       SDL::statPresents_{ 0 };
+std::atomic<uint64_t>       SDL::statUploadBytes_{ 0 };
+
+namespace
+{
+	SDL_FRect toFRect(const SDL_Rect& rect)
+	{
+		return { static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h) };
+	}
+
+	// Presents a layer's copies must stay the same before it is cached, the
+	// fewest copies worth a cache, and the most cached runs per screen
+	const int    layerCacheFrames = 2;
+	const size_t layerCacheCopies = 4;
+	const size_t maxLayerCaches = 3;
+
+	// Dirty textures pile up while no frame is drawn, e.g. during a game
+	const size_t maxDirtyTextures = 1024;
+}
 
 // Initialize SDL
 bool SDL::initialize(Configuration& config)
@@ -98,9 +138,32 @@ bool SDL::initialize(Configuration& config)
 	LOG_INFO("SDL", "Number of displays found: " + std::to_string(numDisplays_));
 	LOG_INFO("SDL", "Number of displays requested: " + std::to_string(numScreens_));
 
+	// Renderer batching is read when the renderer is created. Every frame is drawn
+	// while holding the SDL mutex and ends with a present, so no queued commands
+	// are left behind for the loader threads that also take the mutex.
+	bool renderBatching = true;
+	config.getProperty(OPTION_RENDERBATCHING, renderBatching);
+	renderBatching_ = renderBatching;
+	SDL_SetHint(SDL_HINT_RENDER_BATCHING, renderBatching ? "1" : "0");
+	config.getProperty(OPTION_SKIPIDLEFRAMES, skipIdleFrames_);
+	config.getProperty(OPTION_DIRECTRENDER, directRender_);
+	bool layerCache = true;
+	config.getProperty(OPTION_LAYERCACHE, layerCache);
+	layerCache_ = layerCache;
+	int textureBudget = 0;
+	config.getProperty(OPTION_TEXTUREBUDGET, textureBudget);
+	TextureRegistry::setBudget(static_cast<uint64_t>(std::max(textureBudget, 0)) * 1024 * 1024);
+	// Cached layers hold premultiplied colors
+	premultipliedBlend_ = SDL_ComposeCustomBlendMode(
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+	SDL_AddEventWatch(eventWatch, nullptr);
+
 	// Preset the SDL settings for all monitors
 	int mainScreen = 0;
 	screenCount_ = std::min(numScreens_, numDisplays_);
+	transforms_.assign(screenCount_, ScreenTransform());
+	frames_.assign(screenCount_, ScreenFrame());
 	for (int screenNum = 0; screenNum < screenCount_; ++screenNum)
 	{
 		SDL_DisplayMode mode;
@@ -318,14 +381,20 @@ bool SDL::initialize(Configuration& config)
 			}
 			else
 			{
-				SDL_SetHint(SDL_HINT_RENDER_BATCHING, "0");
 				SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, 0);
-				// Create a render target texture for this screen
-				SDL_Texture* renderTarget = SDL_CreateTexture(renderer_[screenNum],
-					SDL_PIXELFORMAT_RGBA32,
-					SDL_TEXTUREACCESS_TARGET,
-					windowWidth_[screenNum],
-					windowHeight_[screenNum]);
+				// Create a render target texture for this screen, unless it can be
+				// drawn straight to the window
+				bool direct = directRender_ && rotation_[screenNum] == 0 && !mirror_[screenNum];
+				SDL_Texture* renderTarget = nullptr;
+				if (!direct)
+				{
+					renderTarget = SDL_CreateTexture(renderer_[screenNum],
+						SDL_PIXELFORMAT_RGBA32,
+						SDL_TEXTUREACCESS_TARGET,
+						windowWidth_[screenNum],
+						windowHeight_[screenNum]);
+					TextureRegistry::add(renderTarget, TextureRegistry::OwnerTarget, screenNum);
+				}
 
 				std::string ScaleQuality = "1";
 				config.getProperty(OPTION_SCALEQUALITY, ScaleQuality);
@@ -334,7 +403,12 @@ bool SDL::initialize(Configuration& config)
 					LOG_ERROR("SDL", "Improve scale quality. Continuing with low-quality settings 1 = linear. 0 = nearest, 2 = best (linear)");
 				}
 
-				if (renderTarget == NULL)
+				if (direct)
+				{
+					LOG_INFO("SDL", "Screen " + screenIndex + " renders directly to the window, saving a " +
+						std::to_string(windowWidth_[screenNum]) + "x" + std::to_string(windowHeight_[screenNum]) + " copy per frame");
+				}
+				else if (renderTarget == NULL)
 				{
 					std::string error = SDL_GetError();
 					LOG_ERROR("SDL", "Create render target texture failed: " + error);
@@ -380,6 +454,30 @@ bool SDL::initialize(Configuration& config)
 		}
 	}
 
+	// OpenGL contexts are bound to one thread at a time, so those renderers are
+	// always driven from the thread that draws the page
+	bool parallelRender = false;
+	config.getProperty(OPTION_PARALLELRENDER, parallelRender);
+	if (parallelRender && screenCount_ > 1)
+	{
+		for (int i = 0; i < screenCount_; ++i)
+		{
+			SDL_RendererInfo info;
+			if (SDL_GetRendererInfo(renderer_[i], &info) != 0 || strncmp(info.name, "opengl", 6) == 0)
+			{
+				LOG_WARNING("SDL", "Parallel rendering is not supported by renderer " + std::to_string(i) + ", rendering screens in turn");
+				parallelRender = false;
+				break;
+			}
+		}
+		if (parallelRender)
+		{
+			for (int i = 0; i < screenCount_; ++i)
+				renderThreads_.push_back(std::make_unique<ThreadPool>(1));
+			LOG_INFO("SDL", "Presenting " + std::to_string(screenCount_) + " screens from separate render threads");
+		}
+	}
+
 	bool minimizeOnFocusLoss;
 	if (config.getProperty(OPTION_MINIMIZEONFOCUSLOSS, minimizeOnFocusLoss))
 	{
@@ -435,15 +533,24 @@ bool SDL::deInitialize()
 		mutex_ = nullptr;
 	}
 
+	renderThreads_.clear();
+
 	// Destroy render target textures
 	for (auto texture : renderTargets_)
 	{
 		if (texture)
 		{
-			SDL_DestroyTexture(texture);
+			TextureRegistry::destroy(texture);
 		}
 	}
 	renderTargets_.clear();
+	transforms_.clear();
+	for (ScreenFrame& frame : frames_)
+		releaseLayerCaches(frame, true);
+	frames_.clear();
+	dirtyTextures_.clear();
+	frameDirtyTextures_.clear();
+	SDL_DelEventWatch(eventWatch, nullptr);
 
 	for (int i = 0; i < screenCount_; ++i)
 	{
@@ -519,1306 +626,631 @@ SDL_Texture* SDL::getRenderTarget(int index)
 	return (index < screenCount_ ? renderTargets_[index] : renderTargets_[0]);
 }
 
-// Render a copy of a texture
-bool SDL::renderCopy(SDL_Texture* texture, float alpha, SDL_Rect const* src, SDL_Rect const* dest, ViewInfo& viewInfo, int layoutWidth, int layoutHeight)
+bool SDL::DrawCommand::operator==(const DrawCommand& other) const
 {
+	return texture == other.texture &&
+		src.x == other.src.x && src.y == other.src.y && src.w == other.src.w && src.h == other.src.h &&
+		dest.x == other.dest.x && dest.y == other.dest.y && dest.w == other.dest.w && dest.h == other.dest.h &&
+		angle == other.angle && flip == other.flip &&
+		color.r == other.color.r && color.g == other.color.g && color.b == other.color.b && color.a == other.color.a &&
+		blendMode == other.blendMode && layer == other.layer;
+}
 
-	// Skip rendering if the object is invisible anyway or if renderer does not exist
-	if (alpha == 0 || viewInfo.Monitor >= screenCount_ || !renderer_[viewInfo.Monitor])
-		return true;
-	SDL_GetWindowSize(getWindow(viewInfo.Monitor), &windowWidth_[viewInfo.Monitor], &windowHeight_[viewInfo.Monitor]);
+void SDL::invalidate(SDL_Texture* texture)
+{
+	if (texture) {
+		Uint32 format = 0;
+		int width = 0;
+		int height = 0;
+		if (SDL_QueryTexture(texture, &format, nullptr, &width, &height) == 0) {
+			uint64_t pixels = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+			// Planar YUV has a full size luma plane and quarter size chroma planes
+			bool planar = format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_IYUV ||
+				format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21;
+			statUploadBytes_ += planar ? pixels * 3 / 2 : pixels * SDL_BYTESPERPIXEL(format);
+		}
+		std::lock_guard<std::mutex> lock(dirtyMutex_);
+		dirtyTextures_.push_back(texture);
+		if (dirtyTextures_.size() > maxDirtyTextures) {
+			dirtyTextures_.clear();
+			resets_++;
+		}
+	}
+	else {
+		resets_++;
+	}
+	generation_++;
+}
 
-	float scaleX = (float)windowWidth_[viewInfo.Monitor] / (float)layoutWidth;
-	float scaleY = (float)windowHeight_[viewInfo.Monitor] / (float)layoutHeight;
+SDL::FrameStats SDL::takeFrameStats()
+{
+	FrameStats stats;
+	stats.copies = statCopies_.exchange(0);
+	stats.drawCalls = statDrawCalls_.exchange(0);
+	stats.presents = statPresents_.exchange(0);
+	stats.uploadBytes = statUploadBytes_.exchange(0);
+	return stats;
+}
+
+// Window contents may be lost on expose, resize or a device reset
+int SDL::eventWatch(void*, SDL_Event* event)
+{
+	if (event->type == SDL_RENDER_TARGETS_RESET || event->type == SDL_RENDER_DEVICE_RESET)
+		invalidate();
+	else if (event->type == SDL_WINDOWEVENT)
+		generation_++;
+	return 0;
+}
 
-	// 90 or 270 degree rotation; change scale factors
-	if (rotation_[viewInfo.Monitor] % 2 == 1) {
-		scaleX = (float)windowHeight_[viewInfo.Monitor] / (float)layoutWidth;
-		scaleY = (float)windowWidth_[viewInfo.Monitor] / (float)layoutHeight;
+void SDL::beginFrame(int first)
+{
+	layer_ = 0;
+	// Components that render into their own textures restore this target afterwards
+	for (int i = first; i < static_cast<int>(frames_.size()); ++i) {
+		frames_[i].commands.clear();
+		SDL_SetRenderTarget(renderer_[i], renderTargets_[i]);
 	}
+}
 
-	if (mirror_[viewInfo.Monitor])
-		scaleY /= 2;
+bool SDL::endFrame(int index)
+{
+	if (index < 0 || index >= static_cast<int>(frames_.size()) || !renderer_[index])
+		return false;
 
-	// Don't print outside the screen in mirror mode
-	if (mirror_[viewInfo.Monitor] && (viewInfo.ContainerWidth < 0 || viewInfo.ContainerHeight < 0)) {
-		viewInfo.ContainerX = 0;
-		viewInfo.ContainerY = 0;
-		viewInfo.ContainerWidth = static_cast<float>(layoutWidth);
-		viewInfo.ContainerHeight = static_cast<float>(layoutHeight);
-	}
+	ScreenFrame& frame = frames_[index];
+	unsigned int generation = generation_.load();
+	if (skipIdleFrames_ && frame.presented && frame.generation == generation && frame.commands == frame.previous)
+		return false;
 
-	SDL_Rect srcRect{};
-	SDL_Rect dstRect{};
-	SDL_Rect srcRectCopy{};
-	SDL_Rect dstRectCopy{};
-	SDL_Rect srcRectOrig{};
-	SDL_Rect dstRectOrig{};
-	double   imageScaleX;
-	double   imageScaleY;
-
-	dstRect.w = dest->w;
-	dstRect.h = dest->h;
-
-	if (fullscreen_[viewInfo.Monitor]) {
-		dstRect.x = dest->x + (displayWidth_[viewInfo.Monitor] - windowWidth_[viewInfo.Monitor]) / 2;
-		dstRect.y = dest->y + (displayHeight_[viewInfo.Monitor] - windowHeight_[viewInfo.Monitor]) / 2;
-	}
-	else {
-		dstRect.x = dest->x;
-		dstRect.y = dest->y;
-	}
+	// Screens without a render target are drawn straight to the window
+	SDL_Renderer* renderer = renderer_[index];
+	SDL_Texture* target = renderTargets_[index];
+	SDL_SetRenderTarget(renderer, target);
+	SDL_SetRenderDrawColor(renderer, 0x0, 0x0, 0x0, 0xFF);
+	SDL_RenderClear(renderer);
 
-	// Create the base fields to check against the container.
-	if (src) {
-		srcRect.x = src->x;
-		srcRect.y = src->y;
-		srcRect.w = src->w;
-		srcRect.h = src->h;
+	if (layerCache_) {
+		submitLayers(index);
 	}
 	else {
-		srcRect.x = 0;
-		srcRect.y = 0;
-		int w = 0;
-		int h = 0;
-		SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
-		srcRect.w = w;
-		srcRect.h = h;
+		releaseLayerCaches(frame, true);
+		submitCommands(index, 0, frame.commands.size());
 	}
 
-	// Define the scale
-	imageScaleX = (dstRect.w > 0) ? static_cast<double>(srcRect.w) / static_cast<double>(dstRect.w) : 0.0;
-	imageScaleY = (dstRect.h > 0) ? static_cast<double>(srcRect.h) / static_cast<double>(dstRect.h) : 0.0;
-
-	// Make two copies
-	srcRectOrig.x = srcRect.x;
-	srcRectOrig.y = srcRect.y;
-	srcRectOrig.w = srcRect.w;
-	srcRectOrig.h = srcRect.h;
-	dstRectOrig.x = dstRect.x;
-	dstRectOrig.y = dstRect.y;
-	dstRectOrig.w = dstRect.w;
-	dstRectOrig.h = dstRect.h;
-
-	srcRectCopy.x = srcRect.x;
-	srcRectCopy.y = srcRect.y;
-	srcRectCopy.w = srcRect.w;
-	srcRectCopy.h = srcRect.h;
-	dstRectCopy.x = dstRect.x;
-	dstRectCopy.y = dstRect.y;
-	dstRectCopy.w = dstRect.w;
-	dstRectCopy.h = dstRect.h;
-
-	// If a container has been defined, limit the display to the container boundaries.
-	if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-		dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-
-		// Correct if the image falls to the left of the container
-		if (dstRect.x < viewInfo.ContainerX) {
-			dstRect.x = static_cast<int>(viewInfo.ContainerX);
-			dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-			srcRect.x = srcRectCopy.x + srcRectCopy.w * (dstRect.x - dstRectCopy.x) / dstRectCopy.w;
-		}
+	// Switch back to the screen's framebuffer and present the render target
+	if (target) {
+		SDL_SetRenderTarget(renderer, nullptr);
+		SDL_RenderCopy(renderer, target, nullptr, nullptr);
+		statDrawCalls_++;
+	}
+	SDL_RenderPresent(renderer);
+	statPresents_++;
 
-		// Correct if the image falls to the right of the container
-		if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-			dstRect.w = static_cast<int>(viewInfo.ContainerX + viewInfo.ContainerWidth) - dstRect.x;
-		}
+	std::swap(frame.commands, frame.previous);
+	std::swap(frame.layers, frame.previousLayers);
+	frame.generation = generation;
+	frame.presented = true;
+	return true;
+}
 
-		// Correct if the image falls to the top of the container
-		if (dstRect.y < viewInfo.ContainerY) {
-			dstRect.y = static_cast<int>(viewInfo.ContainerY);
-			dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-			srcRect.y = srcRectCopy.y + srcRectCopy.h * (dstRect.y - dstRectCopy.y) / dstRectCopy.h;
-		}
+// Every screen only touches its own renderer and recorded copies, so with
+// parallelRender their draws, presents and vSync waits overlap. The caller
+// holds the SDL mutex, which keeps the loader threads away meanwhile.
+bool SDL::endFrames(int first)
+{
+	{
+		std::lock_guard<std::mutex> lock(dirtyMutex_);
+		frameDirtyTextures_.swap(dirtyTextures_);
+		dirtyTextures_.clear();
+	}
+	std::sort(frameDirtyTextures_.begin(), frameDirtyTextures_.end());
 
-		// Correct if the image falls to the bottom of the container
-		if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-			dstRect.h = static_cast<int>(viewInfo.ContainerY + viewInfo.ContainerHeight) - dstRect.y;
-		}
+	bool presented = false;
+	if (renderThreads_.empty()) {
+		for (int i = first; i < screenCount_; ++i)
+			presented |= endFrame(i);
+		return presented;
+	}
 
-		// Define source width and height
-		srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-		srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	std::vector<std::future<bool>> results;
+	for (int i = first; i < screenCount_; ++i)
+		results.push_back(renderThreads_[i]->enqueue(endFrame, i));
+	for (std::future<bool>& result : results)
+		presented |= result.get();
+	return presented;
+}
 
+// Draw the recorded copies layer by layer. A run of layers whose copies stayed
+// the same over the last presents, without any of their textures changing, is
+// composited once into a texture that later frames copy in a single blit.
+void SDL::submitLayers(int index)
+{
+	ScreenFrame& frame = frames_[index];
+	const std::vector<DrawCommand>& commands = frame.commands;
+	const std::vector<DrawCommand>& previous = frame.previous;
+
+	if (frame.resets != resets_) {
+		frame.resets = resets_;
+		frame.previousLayers.clear();
+		releaseLayerCaches(frame, true);
 	}
 
-	double angle = viewInfo.Angle;
-	if (!mirror_[viewInfo.Monitor])
-		angle += rotation_[viewInfo.Monitor] * 90;
-
-	dstRect.x = (int)(dstRect.x * scaleX);
-	dstRect.y = (int)(dstRect.y * scaleY);
-	dstRect.w = (int)(dstRect.w * scaleX);
-	dstRect.h = (int)(dstRect.h * scaleY);
-
-	if (mirror_[viewInfo.Monitor]) {
-		if (rotation_[viewInfo.Monitor] % 2 == 0) {
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(alpha * 255));
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-				angle += 180;
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-			}
-		}
-		else {
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				int tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-				angle += 90;
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(alpha * 255));
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-				angle += 180;
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-			}
-		}
+	frame.layers.clear();
+	for (size_t i = 0; i < commands.size(); ++i) {
+		if (frame.layers.empty() || frame.layers.back().layer != commands[i].layer)
+			frame.layers.push_back({ commands[i].layer, i, i + 1, 0 });
+		else
+			frame.layers.back().last = i + 1;
 	}
-	else {
-		// 90 degree rotation
-		if (rotation_[viewInfo.Monitor] == 1) {
-			int tmp = dstRect.x;
-			dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-			dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-		}
-		// 180 degree rotation
-		if (rotation_[viewInfo.Monitor] == 2) {
-			dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-			dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-		}
-		// 270 degree rotation
-		if (rotation_[viewInfo.Monitor] == 3) {
-			int tmp = dstRect.x;
-			dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-			dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-		}
 
-		if (srcRect.h > 0 && srcRect.w > 0) {
-			SDL_SetTextureAlphaMod(texture, static_cast<char>(alpha * 255));
-			SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-		}
+	size_t p = 0;
+	for (LayerRange& range : frame.layers) {
+		while (p < frame.previousLayers.size() && frame.previousLayers[p].layer < range.layer)
+			++p;
+		if (p == frame.previousLayers.size() || frame.previousLayers[p].layer != range.layer)
+			continue;
+
+		const LayerRange& last = frame.previousLayers[p];
+		if (range.last - range.first != last.last - last.first ||
+			!std::equal(commands.begin() + range.first, commands.begin() + range.last, previous.begin() + last.first))
+			continue;
+
+		// Other blend modes can't be composited ahead of what is below them
+		bool cacheable = std::all_of(commands.begin() + range.first, commands.begin() + range.last, [](const DrawCommand& command) {
+			return (command.blendMode == SDL_BLENDMODE_BLEND || command.blendMode == SDL_BLENDMODE_ADD) &&
+				!std::binary_search(frameDirtyTextures_.begin(), frameDirtyTextures_.end(), command.texture);
+		});
+		if (cacheable)
+			range.stableFrames = last.stableFrames + 1;
 	}
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("top") != std::string::npos) {
-		dstRect.h = static_cast<unsigned int>(static_cast<float>(dstRect.h) * viewInfo.ReflectionScale);
-		dstRect.y = dstRect.y - dstRect.h - viewInfo.ReflectionDistance;
-		imageScaleY = (dstRect.h > 0) ? static_cast<double>(srcRect.h) / static_cast<double>(dstRect.h) : 0.0;
-		dstRectCopy.y = dstRect.y;
-		dstRectCopy.h = dstRect.h;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = static_cast<int>(viewInfo.ContainerX);
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-				srcRect.x = srcRectCopy.x + srcRectCopy.w * (dstRect.x - dstRectCopy.x) / dstRectCopy.w;
-			}
-
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = static_cast<int>(viewInfo.ContainerX + viewInfo.ContainerWidth) - dstRect.x;
-			}
-
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = static_cast<int>(viewInfo.ContainerY);
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-			}
-
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = static_cast<int>(viewInfo.ContainerY + viewInfo.ContainerHeight) - dstRect.y;
-				srcRect.y = srcRectCopy.y + srcRectCopy.h * (dstRectCopy.h - dstRect.h) / dstRectCopy.h;
-			}
-
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	for (LayerCache& cache : frame.layerCaches)
+		cache.used = false;
 
+	size_t layer = 0;
+	while (layer < frame.layers.size()) {
+		size_t end = layer;
+		size_t copies = 0;
+		while (end < frame.layers.size() && frame.layers[end].stableFrames >= layerCacheFrames) {
+			copies += frame.layers[end].last - frame.layers[end].first;
+			++end;
 		}
-
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = (int)(dstRect.x * scaleX);
-		dstRect.y = (int)(dstRect.y * scaleY);
-		dstRect.w = (int)(dstRect.w * scaleX);
-		dstRect.h = (int)(dstRect.h * scaleY);
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					int tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				int tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				int tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-			}
+		if (copies >= layerCacheCopies && submitCachedLayers(index, frame.layers[layer], frame.layers[end - 1])) {
+			layer = end;
+			continue;
 		}
+		end = std::max(end, layer + 1);
+		submitCommands(index, frame.layers[layer].first, frame.layers[end - 1].last);
+		layer = end;
 	}
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("bottom") != std::string::npos) {
-		dstRect.y = dstRect.y + dstRect.h + viewInfo.ReflectionDistance;
-		dstRect.h = static_cast<unsigned int>(static_cast<float>(dstRect.h) * viewInfo.ReflectionScale);
-		imageScaleY = (dstRect.h > 0) ? static_cast<double>(srcRect.h) / static_cast<double>(dstRect.h) : 0.0;
-		dstRectCopy.y = dstRect.y;
-		dstRectCopy.h = dstRect.h;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = static_cast<int>(viewInfo.ContainerX);
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-				srcRect.x = srcRectCopy.x + srcRectCopy.w * (dstRect.x - dstRectCopy.x) / dstRectCopy.w;
-			}
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = static_cast<int>(viewInfo.ContainerX + viewInfo.ContainerWidth) - dstRect.x;
-			}
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = static_cast<int>(viewInfo.ContainerY);
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-			}
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = static_cast<int>(viewInfo.ContainerY + viewInfo.ContainerHeight) - dstRect.y;
-				srcRect.y = srcRectCopy.y + srcRectCopy.h * (dstRectCopy.h - dstRect.h) / dstRectCopy.h;
-			}
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
-		}
+	releaseLayerCaches(frame, false);
+}
 
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = (int)(dstRect.x * scaleX);
-		dstRect.y = (int)(dstRect.y * scaleY);
-		dstRect.w = (int)(dstRect.w * scaleX);
-		dstRect.h = (int)(dstRect.h * scaleY);
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					int tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
+// Copy the cache of the layers first to last, compositing it first if needed
+bool SDL::submitCachedLayers(int index, const LayerRange& first, const LayerRange& last)
+{
+	ScreenFrame& frame = frames_[index];
+	SDL_Renderer* renderer = renderer_[index];
+	SDL_Texture* target = renderTargets_[index];
+
+	auto cache = std::find_if(frame.layerCaches.begin(), frame.layerCaches.end(), [&](const LayerCache& c) {
+		return c.firstLayer == first.layer && c.lastLayer == last.layer && !c.used;
+	});
+	if (cache == frame.layerCaches.end()) {
+		if (frame.layerCaches.size() >= maxLayerCaches)
+			return false;
+
+		SDL_Texture* texture = nullptr;
+		if (!frame.spareTextures.empty()) {
+			texture = frame.spareTextures.back();
+			frame.spareTextures.pop_back();
 		}
 		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				int tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				int tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
+			int width = 0;
+			int height = 0;
+			if (target)
+				SDL_QueryTexture(target, nullptr, nullptr, &width, &height);
+			else
+				SDL_GetRendererOutputSize(renderer, &width, &height);
+
+			// Accounted only, the render threads must not wait on evictions
+			texture = TextureRegistry::add(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height),
+				TextureRegistry::OwnerTarget, index);
+			if (!texture || SDL_SetTextureBlendMode(texture, premultipliedBlend_) != 0) {
+				LOG_WARNING("SDL", "Layer caching is not supported by this renderer, disabling it: " + std::string(SDL_GetError()));
+				if (texture)
+					TextureRegistry::destroy(texture);
+				layerCache_ = false;
+				return false;
 			}
 		}
+
+		SDL_SetRenderTarget(renderer, texture);
+		SDL_SetRenderDrawColor(renderer, 0x0, 0x0, 0x0, 0x0);
+		SDL_RenderClear(renderer);
+		submitCommands(index, first.first, last.last);
+		SDL_SetRenderTarget(renderer, target);
+
+		frame.layerCaches.push_back({ first.layer, last.layer, texture, false });
+		cache = std::prev(frame.layerCaches.end());
 	}
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("left") != std::string::npos) {
-		dstRect.w = static_cast<unsigned int>(static_cast<float>(dstRect.w) * viewInfo.ReflectionScale);
-		dstRect.x = dstRect.x - dstRect.w - viewInfo.ReflectionDistance;
-		imageScaleX = (dstRect.h > 0) ? static_cast<double>(srcRect.w) / static_cast<double>(dstRect.w) : 0.0;
-		dstRectCopy.x = dstRect.x;
-		dstRectCopy.w = dstRect.w;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = static_cast<int>(viewInfo.ContainerX);
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-			}
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = static_cast<int>(viewInfo.ContainerX + viewInfo.ContainerWidth) - dstRect.x;
-				srcRect.x = srcRectCopy.x + srcRectCopy.w * (dstRectCopy.w - dstRect.w) / dstRectCopy.w;
-			}
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = static_cast<int>(viewInfo.ContainerY);
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-				srcRect.y = srcRectCopy.y + srcRectCopy.h * (dstRect.y - dstRectCopy.y) / dstRectCopy.h;
-			}
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = static_cast<int>(viewInfo.ContainerY + viewInfo.ContainerHeight) - dstRect.y;
-			}
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	SDL_RenderCopy(renderer, cache->texture, nullptr, nullptr);
+	statDrawCalls_++;
+	cache->used = true;
+	return true;
+}
 
-		}
+// Unused caches keep their texture for the next run of layers to cache, all
+// of them are destroyed when the screen contents were lost
+void SDL::releaseLayerCaches(ScreenFrame& frame, bool all)
+{
+	auto unused = std::remove_if(frame.layerCaches.begin(), frame.layerCaches.end(), [&frame, all](const LayerCache& cache) {
+		if (!all && cache.used)
+			return false;
+		frame.spareTextures.push_back(cache.texture);
+		return true;
+	});
+	frame.layerCaches.erase(unused, frame.layerCaches.end());
 
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = (int)(dstRect.x * scaleX);
-		dstRect.y = (int)(dstRect.y * scaleY);
-		dstRect.w = (int)(dstRect.w * scaleX);
-		dstRect.h = (int)(dstRect.h * scaleY);
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					int tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
+	if (all) {
+		for (SDL_Texture* texture : frame.spareTextures)
+			TextureRegistry::destroy(texture);
+		frame.spareTextures.clear();
+	}
+}
+
+void SDL::submitCommands(int index, size_t begin, size_t end)
+{
+	const std::vector<DrawCommand>& commands = frames_[index].commands;
+	size_t first = begin;
+	while (first < end) {
+		size_t last = first + 1;
+		if (renderBatching_) {
+			while (last < end && commands[last].texture == commands[first].texture)
+				++last;
 		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				int tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				int tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-			}
+		if (last - first > 1 && submitBatch(index, first, last)) {
+			first = last;
+			continue;
+		}
+		for (; first < last; ++first) {
+			const DrawCommand& command = commands[first];
+			SDL_SetTextureColorMod(command.texture, command.color.r, command.color.g, command.color.b);
+			SDL_SetTextureAlphaMod(command.texture, command.color.a);
+			SDL_RenderCopyExF(renderer_[index], command.texture, &command.src, &command.dest, command.angle, nullptr, command.flip);
+			statDrawCalls_++;
 		}
 	}
+}
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("right") != std::string::npos) {
-		dstRect.x = dstRect.x + dstRect.w + viewInfo.ReflectionDistance;
-		dstRect.w = static_cast<unsigned int>(static_cast<float>(dstRect.w) * viewInfo.ReflectionScale);
-		imageScaleX = (dstRect.h > 0) ? static_cast<double>(srcRect.w) / static_cast<double>(dstRect.w) : 0.0;
-		dstRectCopy.x = dstRect.x;
-		dstRectCopy.w = dstRect.w;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = static_cast<int>(viewInfo.ContainerX);
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-			}
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = static_cast<int>(viewInfo.ContainerX + viewInfo.ContainerWidth) - dstRect.x;
-				srcRect.x = srcRectCopy.x + srcRectCopy.w * (dstRectCopy.w - dstRect.w) / dstRectCopy.w;
-			}
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = static_cast<int>(viewInfo.ContainerY);
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-				srcRect.y = srcRectCopy.y + srcRectCopy.h * (dstRect.y - dstRectCopy.y) / dstRectCopy.h;
-			}
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = static_cast<int>(viewInfo.ContainerY + viewInfo.ContainerHeight) - dstRect.y;
-			}
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+// Submit consecutive copies of one texture as a single SDL_RenderGeometry call
+bool SDL::submitBatch(int index, size_t first, size_t last)
+{
+	ScreenFrame& frame = frames_[index];
+	SDL_Texture* texture = frame.commands[first].texture;
+	int textureWidth = 0;
+	int textureHeight = 0;
+	SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+	if (textureWidth <= 0 || textureHeight <= 0)
+		return true;
 
+	frame.vertices.clear();
+	frame.indices.clear();
+	for (size_t i = first; i < last; ++i) {
+		const DrawCommand& command = frame.commands[i];
+		float u0 = static_cast<float>(command.src.x) / textureWidth;
+		float v0 = static_cast<float>(command.src.y) / textureHeight;
+		float u1 = static_cast<float>(command.src.x + command.src.w) / textureWidth;
+		float v1 = static_cast<float>(command.src.y + command.src.h) / textureHeight;
+		if (command.flip & SDL_FLIP_HORIZONTAL)
+			std::swap(u0, u1);
+		if (command.flip & SDL_FLIP_VERTICAL)
+			std::swap(v0, v1);
+
+		// Corners relative to the center of dest, rotated clockwise like SDL_RenderCopyEx
+		float halfW = command.dest.w / 2;
+		float halfH = command.dest.h / 2;
+		float centerX = command.dest.x + halfW;
+		float centerY = command.dest.y + halfH;
+		float cosA = 1.0f;
+		float sinA = 0.0f;
+		if (std::fmod(command.angle, 360.0) != 0.0) {
+			double radians = command.angle * M_PI / 180.0;
+			cosA = static_cast<float>(std::cos(radians));
+			sinA = static_cast<float>(std::sin(radians));
 		}
 
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = (int)(dstRect.x * scaleX);
-		dstRect.y = (int)(dstRect.y * scaleY);
-		dstRect.w = (int)(dstRect.w * scaleX);
-		dstRect.h = (int)(dstRect.h * scaleY);
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					int tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				int tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				int tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyEx(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-			}
+		const float corners[4][4] = {
+			{ -halfW, -halfH, u0, v0 },
+			{  halfW, -halfH, u1, v0 },
+			{  halfW,  halfH, u1, v1 },
+			{ -halfW,  halfH, u0, v1 },
+		};
+
+		int base = static_cast<int>(frame.vertices.size());
+		for (const auto& corner : corners) {
+			SDL_Vertex vertex;
+			vertex.position.x = centerX + corner[0] * cosA - corner[1] * sinA;
+			vertex.position.y = centerY + corner[0] * sinA + corner[1] * cosA;
+			vertex.color = command.color;
+			vertex.tex_coord.x = corner[2];
+			vertex.tex_coord.y = corner[3];
+			frame.vertices.push_back(vertex);
 		}
+		for (int corner : { 0, 1, 2, 0, 2, 3 })
+			frame.indices.push_back(base + corner);
 	}
+
+	if (SDL_RenderGeometry(renderer_[index], texture, frame.vertices.data(), static_cast<int>(frame.vertices.size()),
+		frame.indices.data(), static_cast<int>(frame.indices.size())) != 0) {
+		LOG_WARNING("SDL", "Batched rendering is not supported by this renderer, disabling it: " + std::string(SDL_GetError()));
+		renderBatching_ = false;
+		return false;
+	}
+	statDrawCalls_++;
 	return true;
 }
 
-bool SDL::renderCopyF(SDL_Texture* texture, float alpha, const SDL_Rect* src, const SDL_FRect* dest, ViewInfo& viewInfo, int layoutWidth, int layoutHeight)
+// Record a copy of a texture. The current color and alpha mod of the texture are
+// stored with it, so they may change between recorded copies.
+void SDL::copyEx(int index, SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dest, double angle, SDL_RendererFlip flip)
 {
+	DrawCommand command{ texture, src, dest, angle, flip, {}, SDL_BLENDMODE_NONE, layer_ };
+	SDL_GetTextureColorMod(texture, &command.color.r, &command.color.g, &command.color.b);
+	SDL_GetTextureAlphaMod(texture, &command.color.a);
+	SDL_GetTextureBlendMode(texture, &command.blendMode);
+	frames_[index].commands.push_back(command);
+	statCopies_++;
+}
 
-	// Skip rendering if the object is invisible anyway or if renderer does not exist
-	if (alpha == 0 || viewInfo.Monitor >= screenCount_ || !renderer_[viewInfo.Monitor])
-		return true;
-	SDL_GetWindowSize(getWindow(viewInfo.Monitor), &windowWidth_[viewInfo.Monitor], &windowHeight_[viewInfo.Monitor]);
-
-	float scaleX = (float)windowWidth_[viewInfo.Monitor] / (float)layoutWidth;
-	float scaleY = (float)windowHeight_[viewInfo.Monitor] / (float)layoutHeight;
+// Render a copy of a texture
+bool SDL::renderCopy(SDL_Texture* texture, float alpha, SDL_Rect const* src, SDL_Rect const* dest, ViewInfo& viewInfo, int layoutWidth, int layoutHeight)
+{
+	// Integer rects take the same clipping and placement as float ones
+	const SDL_FRect destF = toFRect(*dest);
+	return renderCopyF(texture, alpha, src, &destF, viewInfo, layoutWidth, layoutHeight);
+}
 
-	// 90 or 270 degree rotation; change scale factors
-	if (rotation_[viewInfo.Monitor] % 2 == 1) {
-		scaleX = (float)windowHeight_[viewInfo.Monitor] / (float)layoutWidth;
-		scaleY = (float)windowWidth_[viewInfo.Monitor] / (float)layoutHeight;
+// Refresh the window sizes once per frame instead of on every copy
+void SDL::updateTransforms()
+{
+	for (int i = 0; i < screenCount_; ++i) {
+		if (!window_[i])
+			continue;
+		int width = 0;
+		int height = 0;
+		SDL_GetWindowSize(window_[i], &width, &height);
+		if (width != windowWidth_[i] || height != windowHeight_[i]) {
+			windowWidth_[i] = width;
+			windowHeight_[i] = height;
+			transforms_[i] = ScreenTransform();
+			invalidate();
+		}
 	}
+}
 
-	if (mirror_[viewInfo.Monitor])
-		scaleY /= 2;
+const SDL::ScreenTransform& SDL::getTransform(int index, int layoutWidth, int layoutHeight)
+{
+	ScreenTransform& transform = transforms_[index];
+	if (transform.layoutWidth != layoutWidth || transform.layoutHeight != layoutHeight) {
+		int width = windowWidth_[index];
+		int height = windowHeight_[index];
+
+		// 90 or 270 degree rotation; change scale factors
+		if (rotation_[index] % 2 == 1)
+			std::swap(width, height);
+
+		transform.scaleX = (float)width / (float)layoutWidth;
+		transform.scaleY = (float)height / (float)layoutHeight;
+		if (mirror_[index])
+			transform.scaleY /= 2;
+
+		transform.offsetX = 0;
+		transform.offsetY = 0;
+		if (fullscreen_[index]) {
+			transform.offsetX = static_cast<float>((displayWidth_[index] - windowWidth_[index]) / 2);
+			transform.offsetY = static_cast<float>((displayHeight_[index] - windowHeight_[index]) / 2);
+		}
 
-	// Don't print outside the screen in mirror mode
-	if (mirror_[viewInfo.Monitor] && (viewInfo.ContainerWidth < 0 || viewInfo.ContainerHeight < 0)) {
-		viewInfo.ContainerX = 0;
-		viewInfo.ContainerY = 0;
-		viewInfo.ContainerWidth = static_cast<float>(layoutWidth);
-		viewInfo.ContainerHeight = static_cast<float>(layoutHeight);
+		transform.layoutWidth = layoutWidth;
+		transform.layoutHeight = layoutHeight;
 	}
+	return transform;
+}
 
-	SDL_Rect srcRect{};
-	SDL_FRect dstRect{};
-	SDL_Rect srcRectCopy{};
-	SDL_FRect dstRectCopy{};
-	SDL_Rect srcRectOrig{};
-	SDL_FRect dstRectOrig{};
-	double   imageScaleX;
-	double   imageScaleY;
-
-	dstRect.w = dest->w;
-	dstRect.h = dest->h;
-
-	if (fullscreen_[viewInfo.Monitor]) {
-		dstRect.x = dest->x + (displayWidth_[viewInfo.Monitor] - windowWidth_[viewInfo.Monitor]) / 2;
-		dstRect.y = dest->y + (displayHeight_[viewInfo.Monitor] - windowHeight_[viewInfo.Monitor]) / 2;
-	}
-	else {
-		dstRect.x = dest->x;
-		dstRect.y = dest->y;
-	}
+bool SDL::isOutside(const ViewInfo& viewInfo, SDL_FRect dest, int layoutWidth, int layoutHeight)
+{
+	int index = viewInfo.Monitor;
+	if (index < 0 || index >= screenCount_ || dest.w <= 0 || dest.h <= 0)
+		return true;
 
-	// Create the base fields to check against the container.
-	if (src) {
-		srcRect.x = src->x;
-		srcRect.y = src->y;
-		srcRect.w = src->w;
-		srcRect.h = src->h;
+	const ScreenTransform& transform = getTransform(index, layoutWidth, layoutHeight);
+	dest.x += transform.offsetX;
+	dest.y += transform.offsetY;
+
+	// The container clips the copy before it is rotated
+	if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0) {
+		float left = std::max(dest.x, viewInfo.ContainerX);
+		float top = std::max(dest.y, viewInfo.ContainerY);
+		float right = std::min(dest.x + dest.w, viewInfo.ContainerX + viewInfo.ContainerWidth);
+		float bottom = std::min(dest.y + dest.h, viewInfo.ContainerY + viewInfo.ContainerHeight);
+		if (right <= left || bottom <= top)
+			return true;
+		dest = { left, top, right - left, bottom - top };
 	}
-	else {
-		srcRect.x = 0;
-		srcRect.y = 0;
-		int w = 0;
-		int h = 0;
-		SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
-		srcRect.w = w;
-		srcRect.h = h;
+
+	// A rotated copy turns around its center, test the circle through its corners
+	if (std::fmod(viewInfo.Angle, 360.0f) != 0.0f) {
+		float radius = std::sqrt(dest.w * dest.w + dest.h * dest.h) / 2;
+		dest = { dest.x + dest.w / 2 - radius, dest.y + dest.h / 2 - radius, 2 * radius, 2 * radius };
 	}
 
-	// Define the scale
-	imageScaleX = (dstRect.w > 0) ? static_cast<double>(srcRect.w) / static_cast<double>(dstRect.w) : 0.0;
-	imageScaleY = (dstRect.h > 0) ? static_cast<double>(srcRect.h) / static_cast<double>(dstRect.h) : 0.0;
-
-	// Make two copies
-	srcRectOrig.x = srcRect.x;
-	srcRectOrig.y = srcRect.y;
-	srcRectOrig.w = srcRect.w;
-	srcRectOrig.h = srcRect.h;
-	dstRectOrig.x = dstRect.x;
-	dstRectOrig.y = dstRect.y;
-	dstRectOrig.w = dstRect.w;
-	dstRectOrig.h = dstRect.h;
-
-	srcRectCopy.x = srcRect.x;
-	srcRectCopy.y = srcRect.y;
-	srcRectCopy.w = srcRect.w;
-	srcRectCopy.h = srcRect.h;
-	dstRectCopy.x = dstRect.x;
-	dstRectCopy.y = dstRect.y;
-	dstRectCopy.w = dstRect.w;
-	dstRectCopy.h = dstRect.h;
-
-	// If a container has been defined, limit the display to the container boundaries.
-	if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-		dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-
-		// Correct if the image falls to the left of the container
-		if (dstRect.x < viewInfo.ContainerX) {
-			dstRect.x = viewInfo.ContainerX;
-			dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-			srcRect.x = srcRectCopy.x + static_cast<int>(srcRectCopy.w * (dstRect.x - dstRectCopy.x) / dstRectCopy.w);
-		}
+	return dest.x >= layoutWidth || dest.y >= layoutHeight || dest.x + dest.w <= 0 || dest.y + dest.h <= 0;
+}
 
-		// Correct if the image falls to the right of the container
-		if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-			dstRect.w = viewInfo.ContainerX + viewInfo.ContainerWidth - dstRect.x;
-		}
+// Limit dest to the container boundaries and trim src by the same amount. With a
+// flip the trimmed edge of the source is on the opposite side.
+void SDL::clipToContainer(const ViewInfo& viewInfo, SDL_RendererFlip flip, SDL_Rect& src, SDL_FRect& dest)
+{
+	if (viewInfo.ContainerWidth <= 0 || viewInfo.ContainerHeight <= 0 || dest.w <= 0 || dest.h <= 0)
+		return;
+
+	const SDL_Rect s = src;
+	const SDL_FRect d = dest;
+	double imageScaleX = static_cast<double>(s.w) / static_cast<double>(d.w);
+	double imageScaleY = static_cast<double>(s.h) / static_cast<double>(d.h);
+
+	float left = std::max(d.x, viewInfo.ContainerX);
+	float top = std::max(d.y, viewInfo.ContainerY);
+	float right = std::min(d.x + d.w, viewInfo.ContainerX + viewInfo.ContainerWidth);
+	float bottom = std::min(d.y + d.h, viewInfo.ContainerY + viewInfo.ContainerHeight);
+
+	dest.x = left;
+	dest.y = top;
+	dest.w = right - left;
+	dest.h = bottom - top;
+
+	float skipX = (flip & SDL_FLIP_HORIZONTAL) ? d.x + d.w - right : left - d.x;
+	float skipY = (flip & SDL_FLIP_VERTICAL) ? d.y + d.h - bottom : top - d.y;
+	src.x = s.x + static_cast<int>(s.w * skipX / d.w);
+	src.y = s.y + static_cast<int>(s.h * skipY / d.h);
+	src.w = static_cast<int>(dest.w * imageScaleX);
+	src.h = static_cast<int>(dest.h * imageScaleY);
+}
 
-		// Correct if the image falls to the top of the container
-		if (dstRect.y < viewInfo.ContainerY) {
-			dstRect.y = viewInfo.ContainerY;
-			dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-			srcRect.y = srcRectCopy.y + static_cast<int>(srcRectCopy.h * (dstRect.y - dstRectCopy.y) / dstRectCopy.h);
-		}
+// Scale a copy from layout to window coordinates, apply the screen rotation or
+// mirror and queue it
+void SDL::placeCopy(int index, const ScreenTransform& transform, SDL_Texture* texture, float alpha, const SDL_Rect& src, SDL_FRect dest, double angle, SDL_RendererFlip flip)
+{
+	if (src.w <= 0 || src.h <= 0)
+		return;
 
-		// Correct if the image falls to the bottom of the container
-		if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-			dstRect.h = static_cast<int>(viewInfo.ContainerY + viewInfo.ContainerHeight) - dstRect.y;
-		}
+	int windowWidth = windowWidth_[index];
+	int windowHeight = windowHeight_[index];
+	int rotation = rotation_[index];
 
-		// Define source width and height
-		srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-		srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	dest.x *= transform.scaleX;
+	dest.y *= transform.scaleY;
+	dest.w *= transform.scaleX;
+	dest.h *= transform.scaleY;
 
-	}
+	SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(alpha * 255));
 
-	double angle = viewInfo.Angle;
-	if (!mirror_[viewInfo.Monitor])
-		angle += rotation_[viewInfo.Monitor] * 90;
-
-	dstRect.x = dstRect.x * scaleX;
-	dstRect.y = dstRect.y * scaleY;
-	dstRect.w = dstRect.w * scaleX;
-	dstRect.h = dstRect.h * scaleY;
-
-	if (mirror_[viewInfo.Monitor]) {
-		if (rotation_[viewInfo.Monitor] % 2 == 0) {
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(alpha * 255));
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-				angle += 180;
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-			}
+	if (mirror_[index]) {
+		if (rotation % 2 == 0) {
+			dest.y += windowHeight / 2;
 		}
 		else {
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				float tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-				angle += 90;
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(alpha * 255));
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-				angle += 180;
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
-			}
-		}
-	}
-	else {
-		// 90 degree rotation
-		if (rotation_[viewInfo.Monitor] == 1) {
-			float tmp = dstRect.x;
-			dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-			dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-		}
-		// 180 degree rotation
-		if (rotation_[viewInfo.Monitor] == 2) {
-			dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-			dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-		}
-		// 270 degree rotation
-		if (rotation_[viewInfo.Monitor] == 3) {
-			float tmp = dstRect.x;
-			dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-			dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-		}
-
-		if (srcRect.h > 0 && srcRect.w > 0) {
-			SDL_SetTextureAlphaMod(texture, static_cast<char>(alpha * 255));
-			SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_NONE);
+			float tmp = dest.x;
+			dest.x = windowWidth / 2 - dest.y - dest.h / 2 - dest.w / 2;
+			dest.y = tmp - dest.h / 2 + dest.w / 2;
+			angle += 90;
 		}
+		copyEx(index, texture, src, dest, angle, flip);
+		dest.x = windowWidth - dest.x - dest.w;
+		dest.y = windowHeight - dest.y - dest.h;
+		angle += 180;
+		copyEx(index, texture, src, dest, angle, flip);
+		return;
 	}
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("top") != std::string::npos) {
-		dstRect.h = dstRect.h * viewInfo.ReflectionScale;
-		dstRect.y = dstRect.y - dstRect.h - viewInfo.ReflectionDistance;
-		imageScaleY = (dstRect.h > 0) ? static_cast<double>(srcRect.h) / static_cast<double>(dstRect.h) : 0.0;
-		dstRectCopy.y = dstRect.y;
-		dstRectCopy.h = dstRect.h;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = viewInfo.ContainerX;
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-				srcRect.x = srcRectCopy.x + static_cast<int>(srcRectCopy.w * (dstRect.x - dstRectCopy.x) / dstRectCopy.w);
-			}
-
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = viewInfo.ContainerX + viewInfo.ContainerWidth - dstRect.x;
-			}
+	angle += rotation * 90;
 
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = viewInfo.ContainerY;
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-			}
+	// 90 degree rotation
+	if (rotation == 1) {
+		float tmp = dest.x;
+		dest.x = windowWidth - dest.y - dest.h / 2 - dest.w / 2;
+		dest.y = tmp - dest.h / 2 + dest.w / 2;
+	}
+	// 180 degree rotation
+	else if (rotation == 2) {
+		dest.x = windowWidth - dest.x - dest.w;
+		dest.y = windowHeight - dest.y - dest.h;
+	}
+	// 270 degree rotation
+	else if (rotation == 3) {
+		float tmp = dest.x;
+		dest.x = dest.y + dest.h / 2 - dest.w / 2;
+		dest.y = windowHeight - tmp - dest.h / 2 - dest.w / 2;
+	}
+	copyEx(index, texture, src, dest, angle, flip);
+}
 
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = viewInfo.ContainerY + viewInfo.ContainerHeight - dstRect.y;
-				srcRect.y = srcRectCopy.y + static_cast<int>(srcRectCopy.h * (dstRectCopy.h - dstRect.h) / dstRectCopy.h);
-			}
+bool SDL::renderCopyF(SDL_Texture* texture, float alpha, const SDL_Rect* src, const SDL_FRect* dest, ViewInfo& viewInfo, int layoutWidth, int layoutHeight)
+{
 
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	// Skip rendering if the object is invisible anyway or if renderer does not exist
+	if (alpha == 0 || viewInfo.Monitor >= screenCount_ || !renderer_[viewInfo.Monitor])
+		return true;
 
-		}
+	int index = viewInfo.Monitor;
+	const ScreenTransform& transform = getTransform(index, layoutWidth, layoutHeight);
 
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = dstRect.x * scaleX;
-		dstRect.y = dstRect.y * scaleY;
-		dstRect.w = dstRect.w * scaleX;
-		dstRect.h = dstRect.h * scaleY;
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					float tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				float tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				float tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-			}
-		}
+	// Don't print outside the screen in mirror mode
+	if (mirror_[index] && (viewInfo.ContainerWidth < 0 || viewInfo.ContainerHeight < 0)) {
+		viewInfo.ContainerX = 0;
+		viewInfo.ContainerY = 0;
+		viewInfo.ContainerWidth = static_cast<float>(layoutWidth);
+		viewInfo.ContainerHeight = static_cast<float>(layoutHeight);
 	}
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("bottom") != std::string::npos) {
-		dstRect.y = dstRect.y + dstRect.h + viewInfo.ReflectionDistance;
-		dstRect.h = std::max(0.0f, dstRect.h * viewInfo.ReflectionScale);
-		imageScaleY = (dstRect.h > 0) ? static_cast<double>(srcRect.h) / static_cast<double>(dstRect.h) : 0.0;
-		dstRectCopy.y = dstRect.y;
-		dstRectCopy.h = dstRect.h;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = viewInfo.ContainerX;
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-				srcRect.x = srcRectCopy.x + static_cast<int>(srcRectCopy.w * (dstRect.x - dstRectCopy.x) / dstRectCopy.w);
-			}
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = static_cast<int>(viewInfo.ContainerX + viewInfo.ContainerWidth) - dstRect.x;
-			}
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = viewInfo.ContainerY;
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-			}
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = viewInfo.ContainerY + viewInfo.ContainerHeight - dstRect.y;
-				srcRect.y = srcRectCopy.y + static_cast<int>(srcRectCopy.h * (dstRectCopy.h - dstRect.h) / dstRectCopy.h);
-			}
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
-		}
-
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = dstRect.x * scaleX;
-		dstRect.y = dstRect.y * scaleY;
-		dstRect.w = dstRect.w * scaleX;
-		dstRect.h = dstRect.h * scaleY;
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					float tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-				}
-			}
-		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				float tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				float tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_VERTICAL);
-			}
-		}
+	// Create the base fields to check against the container.
+	SDL_Rect srcRect{};
+	if (src) {
+		srcRect = *src;
+	}
+	else {
+		SDL_QueryTexture(texture, nullptr, nullptr, &srcRect.w, &srcRect.h);
 	}
+	const SDL_FRect dstRect = { dest->x + transform.offsetX, dest->y + transform.offsetY, dest->w, dest->h };
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("left") != std::string::npos) {
-		dstRect.w = std::max(0.0f, dstRect.w * viewInfo.ReflectionScale);
-		dstRect.x = dstRect.x - dstRect.w - viewInfo.ReflectionDistance;
-		imageScaleX = (dstRect.h > 0) ? static_cast<double>(srcRect.w) / static_cast<double>(dstRect.w) : 0.0;
-		dstRectCopy.x = dstRect.x;
-		dstRectCopy.w = dstRect.w;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = viewInfo.ContainerX;
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-			}
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = viewInfo.ContainerX + viewInfo.ContainerWidth - dstRect.x;
-				srcRect.x = srcRectCopy.x + static_cast<int>(srcRectCopy.w * (dstRectCopy.w - dstRect.w) / dstRectCopy.w);
-			}
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = viewInfo.ContainerY;
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-				srcRect.y = srcRectCopy.y + static_cast<int>(srcRectCopy.h * (dstRect.y - dstRectCopy.y) / dstRectCopy.h);
-			}
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = viewInfo.ContainerY + viewInfo.ContainerHeight - dstRect.y;
-			}
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	SDL_Rect clipSrc = srcRect;
+	SDL_FRect clipDst = dstRect;
+	clipToContainer(viewInfo, SDL_FLIP_NONE, clipSrc, clipDst);
+	placeCopy(index, transform, texture, alpha, clipSrc, clipDst, viewInfo.Angle, SDL_FLIP_NONE);
 
-		}
+	if (viewInfo.style().Reflection.empty())
+		return true;
 
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = dstRect.x * scaleX;
-		dstRect.y = dstRect.y * scaleY;
-		dstRect.w = dstRect.w * scaleX;
-		dstRect.h = dstRect.h * scaleY;
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					float tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				float tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				float tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-			}
-		}
-	}
+	float reflectionAlpha = viewInfo.style().ReflectionAlpha * alpha;
 
-	// Restore original parameters
-	srcRect.x = srcRectOrig.x;
-	srcRect.y = srcRectOrig.y;
-	srcRect.w = srcRectOrig.w;
-	srcRect.h = srcRectOrig.h;
-	dstRect.x = dstRectOrig.x;
-	dstRect.y = dstRectOrig.y;
-	dstRect.w = dstRectOrig.w;
-	dstRect.h = dstRectOrig.h;
-	srcRectCopy.x = srcRectOrig.x;
-	srcRectCopy.y = srcRectOrig.y;
-	srcRectCopy.w = srcRectOrig.w;
-	srcRectCopy.h = srcRectOrig.h;
-	dstRectCopy.x = dstRectOrig.x;
-	dstRectCopy.y = dstRectOrig.y;
-	dstRectCopy.w = dstRectOrig.w;
-	dstRectCopy.h = dstRectOrig.h;
-
-	if (viewInfo.Reflection.find("right") != std::string::npos) {
-		dstRect.x = dstRect.x + dstRect.w + viewInfo.ReflectionDistance;
-		dstRect.w = std::max(0.0f, dstRect.w * viewInfo.ReflectionScale);
-		imageScaleX = (dstRect.h > 0) ? static_cast<double>(srcRect.w) / static_cast<double>(dstRect.w) : 0.0;
-		dstRectCopy.x = dstRect.x;
-		dstRectCopy.w = dstRect.w;
-
-		// If a container has been defined, limit the display to the container boundaries.
-		if (viewInfo.ContainerWidth > 0 && viewInfo.ContainerHeight > 0 &&
-			dstRectCopy.w > 0 && dstRectCopy.h > 0) {
-			// Correct if the image falls to the left of the container
-			if (dstRect.x < viewInfo.ContainerX) {
-				dstRect.x = viewInfo.ContainerX;
-				dstRect.w = dstRectCopy.w + dstRectCopy.x - dstRect.x;
-			}
-			// Correct if the image falls to the right of the container
-			if ((dstRectCopy.x + dstRectCopy.w) > (viewInfo.ContainerX + viewInfo.ContainerWidth)) {
-				dstRect.w = viewInfo.ContainerX + viewInfo.ContainerWidth - dstRect.x;
-				srcRect.x = srcRectCopy.x + static_cast<int>(srcRectCopy.w * (dstRectCopy.w - dstRect.w) / dstRectCopy.w);
-			}
-			// Correct if the image falls to the top of the container
-			if (dstRect.y < viewInfo.ContainerY) {
-				dstRect.y = viewInfo.ContainerY;
-				dstRect.h = dstRectCopy.h + dstRectCopy.y - dstRect.y;
-				srcRect.y = srcRectCopy.y + static_cast<int>(srcRectCopy.h * (dstRect.y - dstRectCopy.y) / dstRectCopy.h);
-			}
-			// Correct if the image falls to the bottom of the container
-			if ((dstRectCopy.y + dstRectCopy.h) > (viewInfo.ContainerY + viewInfo.ContainerHeight)) {
-				dstRect.h = viewInfo.ContainerY + viewInfo.ContainerHeight - dstRect.y;
-			}
-			// Define source width and height
-			srcRect.w = static_cast<int>(dstRect.w * imageScaleX);
-			srcRect.h = static_cast<int>(dstRect.h * imageScaleY);
+	if (viewInfo.style().Reflection.find("top") != std::string::npos) {
+		clipSrc = srcRect;
+		clipDst = dstRect;
+		clipDst.h = dstRect.h * viewInfo.style().ReflectionScale;
+		clipDst.y = dstRect.y - clipDst.h - viewInfo.style().ReflectionDistance;
+		clipToContainer(viewInfo, SDL_FLIP_VERTICAL, clipSrc, clipDst);
+		placeCopy(index, transform, texture, reflectionAlpha, clipSrc, clipDst, viewInfo.Angle, SDL_FLIP_VERTICAL);
+	}
 
+	if (viewInfo.style().Reflection.find("bottom") != std::string::npos) {
+		clipSrc = srcRect;
+		clipDst = dstRect;
+		clipDst.y = dstRect.y + dstRect.h + viewInfo.style().ReflectionDistance;
+		clipDst.h = std::max(0.0f, dstRect.h * viewInfo.style().ReflectionScale);
+		clipToContainer(viewInfo, SDL_FLIP_VERTICAL, clipSrc, clipDst);
+		placeCopy(index, transform, texture, reflectionAlpha, clipSrc, clipDst, viewInfo.Angle, SDL_FLIP_VERTICAL);
+	}
 
-		}
+	if (viewInfo.style().Reflection.find("left") != std::string::npos) {
+		clipSrc = srcRect;
+		clipDst = dstRect;
+		clipDst.w = std::max(0.0f, dstRect.w * viewInfo.style().ReflectionScale);
+		clipDst.x = dstRect.x - clipDst.w - viewInfo.style().ReflectionDistance;
+		clipToContainer(viewInfo, SDL_FLIP_HORIZONTAL, clipSrc, clipDst);
+		placeCopy(index, transform, texture, reflectionAlpha, clipSrc, clipDst, viewInfo.Angle, SDL_FLIP_HORIZONTAL);
+	}
 
-		angle = viewInfo.Angle;
-		if (!mirror_[viewInfo.Monitor])
-			angle += rotation_[viewInfo.Monitor] * 90;
-
-		dstRect.x = dstRect.x * scaleX;
-		dstRect.y = dstRect.y * scaleY;
-		dstRect.w = dstRect.w * scaleX;
-		dstRect.h = dstRect.h * scaleY;
-
-		if (mirror_[viewInfo.Monitor]) {
-			if (rotation_[viewInfo.Monitor] % 2 == 0) {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					dstRect.y += windowHeight_[viewInfo.Monitor] / 2;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-			else {
-				if (srcRect.h > 0 && srcRect.w > 0) {
-					float tmp = dstRect.x;
-					dstRect.x = windowWidth_[viewInfo.Monitor] / 2 - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-					dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-					angle += 90;
-					SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-					dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-					dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-					angle += 180;
-					SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-				}
-			}
-		}
-		else {
-			// 90 degree rotation
-			if (rotation_[viewInfo.Monitor] == 1) {
-				float tmp = dstRect.x;
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.y - dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = tmp - dstRect.h / 2 + dstRect.w / 2;
-			}
-			// 180 degree rotation
-			if (rotation_[viewInfo.Monitor] == 2) {
-				dstRect.x = windowWidth_[viewInfo.Monitor] - dstRect.x - dstRect.w;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - dstRect.y - dstRect.h;
-			}
-			// 270 degree rotation
-			if (rotation_[viewInfo.Monitor] == 3) {
-				float tmp = dstRect.x;
-				dstRect.x = dstRect.y + dstRect.h / 2 - dstRect.w / 2;
-				dstRect.y = windowHeight_[viewInfo.Monitor] - tmp - dstRect.h / 2 - dstRect.w / 2;
-			}
-			if (srcRect.h > 0 && srcRect.w > 0) {
-				SDL_SetTextureAlphaMod(texture, static_cast<char>(viewInfo.ReflectionAlpha * alpha * 255));
-				SDL_RenderCopyExF(renderer_[viewInfo.Monitor], texture, &srcRect, &dstRect, angle, nullptr, SDL_FLIP_HORIZONTAL);
-			}
-		}
+	if (viewInfo.style().Reflection.find("right") != std::string::npos) {
+		clipSrc = srcRect;
+		clipDst = dstRect;
+		clipDst.x = dstRect.x + dstRect.w + viewInfo.style().ReflectionDistance;
+		clipDst.w = std::max(0.0f, dstRect.w * viewInfo.style().ReflectionScale);
+		clipToContainer(viewInfo, SDL_FLIP_HORIZONTAL, clipSrc, clipDst);
+		placeCopy(index, transform, texture, reflectionAlpha, clipSrc, clipDst, viewInfo.Angle, SDL_FLIP_HORIZONTAL);
 	}
+
 	return true;
 }
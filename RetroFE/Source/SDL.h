@@ -17,17 +17,30 @@
 
 
 #include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include "Graphics/ViewInfo.h"
 #include <vector>
 
 
 class Configuration;
+class ThreadPool;
 
 
 class SDL
 {
 public:
+    // Work done by the renderer since the last takeFrameStats call
+    struct FrameStats
+    {
+        uint64_t copies = 0;      // recorded by renderCopy
+        uint64_t drawCalls = 0;   // submitted to the renderer
+        uint64_t presents = 0;
+        uint64_t uploadBytes = 0; // of textures passed to invalidate
+    };
+
     static bool initialize( Configuration &config );
     static bool deInitialize( );
     static SDL_Renderer *getRenderer( int index );
@@ -37,6 +50,28 @@ public:
     static SDL_Texture* getRenderTarget(int index);
     static bool renderCopy( SDL_Texture *texture, float alpha, SDL_Rect const *src, SDL_Rect const *dest, ViewInfo &viewInfo, int layoutWidth, int layoutHeight );
     static bool renderCopyF(SDL_Texture* texture, float alpha, const SDL_Rect* src, const SDL_FRect* dest, ViewInfo& viewInfo, int layoutWidth, int layoutHeight);
+    // True when renderCopyF to dest would be clipped away by the container or the screen edges
+    static bool isOutside( const ViewInfo &viewInfo, SDL_FRect dest, int layoutWidth, int layoutHeight );
+    // Picks up window size changes, call once per frame before drawing
+    static void updateTransforms( );
+    // renderCopy only records copies between beginFrame and endFrame. endFrame
+    // draws and presents the screen, or does nothing when the recorded copies
+    // match the previous frame and no texture has changed since. Screens below
+    // first are left alone, as a launched game owns them.
+    static void beginFrame( int first = 0 );
+    static bool endFrame( int index );
+    // endFrame for screens first and up, returns false if none was presented
+    static bool endFrames( int first = 0 );
+    // Call after changing the pixels of a texture or creating a new one, or
+    // without a texture when the contents of the screens may have been lost
+    static void invalidate( SDL_Texture *texture = nullptr );
+    static FrameStats takeFrameStats( );
+    // Layer of the copies recorded from now on. Runs of layers whose copies
+    // stay the same are composited once into a cached texture.
+    static void setLayer( unsigned int layer )
+    {
+        layer_ = layer;
+    }
     static int getScreenCount( ) 
 	{
         return screenCount_;
@@ -64,6 +99,7 @@ public:
     static void setRotation(int index, int rotation)
     {
         rotation_[index] = rotation;
+        transforms_[index] = ScreenTransform();
     }
     static int getRotation(int index)
     {
@@ -71,6 +107,78 @@ public:
     }
 
 private:
+    // Scale and fullscreen offset from layout to window coordinates
+    struct ScreenTransform
+    {
+        int   layoutWidth = 0;
+        int   layoutHeight = 0;
+        float scaleX = 1.0f;
+        float scaleY = 1.0f;
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+    };
+
+    struct DrawCommand
+    {
+        SDL_Texture     *texture;
+        SDL_Rect         src;
+        SDL_FRect        dest;
+        double           angle;
+        SDL_RendererFlip flip;
+        SDL_Color        color;
+        SDL_BlendMode    blendMode;
+        unsigned int     layer;
+
+        bool operator==( const DrawCommand &other ) const;
+        bool operator!=( const DrawCommand &other ) const { return !(*this == other); }
+    };
+
+    // Copies of one layer, [first, last) in the recorded copies
+    struct LayerRange
+    {
+        unsigned int layer;
+        size_t       first;
+        size_t       last;
+        int          stableFrames; // presents its copies stayed the same
+    };
+
+    // Composited copies of the layers firstLayer to lastLayer
+    struct LayerCache
+    {
+        unsigned int firstLayer;
+        unsigned int lastLayer;
+        SDL_Texture *texture;
+        bool         used;
+    };
+
+    // Copies recorded for a screen. Consecutive copies of one texture are
+    // submitted as a single SDL_RenderGeometry call.
+    struct ScreenFrame
+    {
+        std::vector<DrawCommand> commands;
+        std::vector<DrawCommand> previous;
+        std::vector<SDL_Vertex>  vertices;
+        std::vector<int>         indices;
+        std::vector<LayerRange>  layers;
+        std::vector<LayerRange>  previousLayers;
+        std::vector<LayerCache>  layerCaches;
+        std::vector<SDL_Texture*> spareTextures; // of layer caches no longer used
+        unsigned int             generation = 0;
+        unsigned int             resets = 0;
+        bool                     presented = false;
+    };
+
+    static const ScreenTransform &getTransform( int index, int layoutWidth, int layoutHeight );
+    static void clipToContainer( const ViewInfo &viewInfo, SDL_RendererFlip flip, SDL_Rect &src, SDL_FRect &dest );
+    static void placeCopy( int index, const ScreenTransform &transform, SDL_Texture *texture, float alpha, const SDL_Rect &src, SDL_FRect dest, double angle, SDL_RendererFlip flip );
+    static void copyEx( int index, SDL_Texture *texture, const SDL_Rect &src, const SDL_FRect &dest, double angle, SDL_RendererFlip flip );
+    static void submitLayers( int index );
+    static bool submitCachedLayers( int index, const LayerRange &first, const LayerRange &last );
+    static void submitCommands( int index, size_t begin, size_t end );
+    static bool submitBatch( int index, size_t first, size_t last );
+    static void releaseLayerCaches( ScreenFrame &frame, bool all );
+    static int  eventWatch( void *userdata, SDL_Event *event );
+
     static std::vector<SDL_Window *>   window_;
     static std::vector<SDL_Renderer *> renderer_;
     static SDL_mutex                  *mutex_;
@@ -85,4 +193,22 @@ private:
     static int                         numDisplays_;
 	static int                         screenCount_;
     static std::vector<SDL_Texture*>   renderTargets_;
+    static std::vector<ScreenTransform> transforms_;
+    static std::vector<ScreenFrame>    frames_;
+    static std::vector<std::unique_ptr<ThreadPool>> renderThreads_;
+    static std::atomic<bool>           renderBatching_;
+    static bool                        skipIdleFrames_;
+    static bool                        directRender_;
+    static std::atomic<unsigned int>   generation_;
+    static std::atomic<unsigned int>   resets_;
+    static std::atomic<bool>           layerCache_;
+    static SDL_BlendMode               premultipliedBlend_;
+    static unsigned int                layer_;
+    static std::mutex                  dirtyMutex_;
+    static std::vector<SDL_Texture*>   dirtyTextures_;
+    static std::vector<SDL_Texture*>   frameDirtyTextures_;
+    static std::atomic<uint64_t>       statCopies_;
+    static std::atomic<uint64_t>       statDrawCalls_;
+    static std::atomic<uint64_t>       statPresents_;
+    static std::atomic<uint64_t>       statUploadBytes_;
 };
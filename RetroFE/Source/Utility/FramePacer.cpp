@@ -0,0 +1,114 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+FramePacer::FramePacer(int fps, int fpsIdle, bool vSync, int refreshRate)
+    : frequency_(SDL_GetPerformanceFrequency())
+    , frameStart_(SDL_GetPerformanceCounter())
+    , deadline_(frameStart_)
+    , lastActive_(frameStart_)
+    , lastPresent_(frameStart_)
+    , activeInterval_(1.0 / std::max(fps, 1))
+    , idleInterval_(1.0 / std::max(fpsIdle, 1))
+    , refreshInterval_(1.0 / (refreshRate > 0 ? refreshRate : 60))
+    , vSync_(vSync)
+{
+}
+
+float FramePacer::nextFrame(bool active, bool presented)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (active) {
+        lastActive_ = now;
+    }
+    double interval = seconds(now - lastActive_) < idleDelay_ ? activeInterval_ : idleInterval_;
+
+    if (vSync_) {
+        if (presented) {
+            // Back to back presents are one refresh apart, anything else is a
+            // skipped frame or a slow one
+            double sincePresent = seconds(now - lastPresent_);
+            if (sincePresent > refreshInterval_ * 0.75 && sincePresent < refreshInterval_ * 1.25) {
+                refreshInterval_ += (sincePresent - refreshInterval_) * 0.05;
+            }
+            lastPresent_ = now;
+
+            // The present already waited for a refresh. A lower frame rate
+            // sleeps until half a refresh before the one it should hit.
+            deadline_ = interval > refreshInterval_ * 1.5
+                ? frameStart_ + ticks(interval - refreshInterval_ / 2)
+                : now;
+        }
+        else {
+            // Nothing blocked on this frame, wait as long as a present would have
+            deadline_ = frameStart_ + ticks(std::max(interval, refreshInterval_));
+        }
+    }
+    else {
+        // Fixed deadlines keep the average rate exact, start over after a stall
+        deadline_ += ticks(interval);
+        if (deadline_ + ticks(interval) < now) {
+            deadline_ = now;
+        }
+    }
+
+    waitUntil(deadline_);
+
+    now = SDL_GetPerformanceCounter();
+    double elapsed = seconds(now - frameStart_);
+    frameStart_ = now;
+    return static_cast<float>(std::min(elapsed, maxFrameTime_));
+}
+
+float FramePacer::maxStep() const
+{
+    return static_cast<float>(std::max(activeInterval_, idleInterval_));
+}
+
+double FramePacer::refreshRate() const
+{
+    return 1.0 / refreshInterval_;
+}
+
+Uint64 FramePacer::ticks(double seconds) const
+{
+    return static_cast<Uint64>(seconds * static_cast<double>(frequency_));
+}
+
+double FramePacer::seconds(Uint64 ticks) const
+{
+    return static_cast<double>(ticks) / static_cast<double>(frequency_);
+}
+
+// SDL_Delay can overshoot by a millisecond or more, so it stops short of the
+// deadline and the rest is spun
+void FramePacer::waitUntil(Uint64 deadline) const
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= deadline) {
+        return;
+    }
+
+    double remaining = seconds(deadline - now);
+    if (remaining > spinTime_) {
+        SDL_Delay(static_cast<Uint32>((remaining - spinTime_) * 1000));
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,57 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Schedules the frames of the main loop on the high resolution counter.
+//
+// Without vSync frames are due at fixed deadlines, reached by sleeping until
+// shortly before and spinning for the rest. With vSync the present does the
+// pacing, the pacer only waits when a frame was skipped or when the frame rate
+// is lower than the refresh rate, which it measures from the presents.
+class FramePacer
+{
+public:
+    FramePacer(int fps, int fpsIdle, bool vSync, int refreshRate);
+
+    // Waits until the next frame is due and returns the seconds since the
+    // previous one. Without activity for a moment the idle frame rate is used.
+    float nextFrame(bool active, bool presented);
+
+    // Largest time step a single update should take
+    float maxStep() const;
+    double refreshRate() const;
+
+private:
+    Uint64 ticks(double seconds) const;
+    double seconds(Uint64 ticks) const;
+    void waitUntil(Uint64 deadline) const;
+
+    static constexpr double idleDelay_ = 0.5;
+    static constexpr double spinTime_ = 0.002;
+    static constexpr double maxFrameTime_ = 0.25;
+
+    Uint64 frequency_;
+    Uint64 frameStart_;
+    Uint64 deadline_;
+    Uint64 lastActive_;
+    Uint64 lastPresent_;
+    double activeInterval_;
+    double idleInterval_;
+    double refreshInterval_;
+    bool   vSync_;
+};
@@ -22,6 +22,7 @@
 #include "GStreamerVideo.h"
 #include "../Database/Configuration.h"
 #include "../Graphics/Component/Image.h"
+#include "../Graphics/TextureRegistry.h"
 #include "../Graphics/ViewInfo.h"
 #include "../SDL.h"
 #include "../Utility/Log.h"
@@ -119,8 +120,8 @@ void GStreamerVideo::createAlphaTexture() {
 		return;
 	}
 
-	alphaTexture_ = SDL_CreateTexture(
-		SDL::getRenderer(monitor_), SDL_PIXELFORMAT_RGBA32,
+	alphaTexture_ = TextureRegistry::create(
+		SDL::getRenderer(monitor_), TextureRegistry::OwnerVideo, monitor_, SDL_PIXELFORMAT_RGBA32,
 		SDL_TEXTUREACCESS_STATIC, ALPHA_TEXTURE_SIZE, ALPHA_TEXTURE_SIZE);
 
 	if (!alphaTexture_) {
@@ -141,6 +142,7 @@ void GStreamerVideo::createAlphaTexture() {
 	}
 	texture_ = alphaTexture_;
 	SDL_UnlockMutex(SDL::getMutex());
+	SDL::invalidate(alphaTexture_);
 }
 
 void GStreamerVideo::messageHandler(float dt) {
@@ -390,19 +392,16 @@ bool GStreamerVideo::stop() {
 		videoInfo_ = nullptr;
 	}
 
-	if (texture_ != nullptr)
-	{
-		SDL_DestroyTexture(texture_);
-		texture_ = nullptr;
-	}
+	// texture_ points at one of the two textures below
+	texture_ = nullptr;
 	if (videoTexture_ != nullptr)
 	{
-		SDL_DestroyTexture(videoTexture_);
+		TextureRegistry::destroy(videoTexture_);
 		videoTexture_ = nullptr;
 	}
 	if (alphaTexture_ != nullptr)
 	{
-		SDL_DestroyTexture(alphaTexture_);
+		TextureRegistry::destroy(alphaTexture_);
 		alphaTexture_ = nullptr;
 	}
 	SDL_UnlockMutex(SDL::getMutex());
@@ -859,7 +858,7 @@ void GStreamerVideo::createSdlTexture() {
 	if (needNewTexture) {
 
 		if (videoTexture_) {
-			SDL_DestroyTexture(videoTexture_);
+			TextureRegistry::destroy(videoTexture_);
 			videoTexture_ = nullptr;
 		}
 		texture_ = nullptr;  // Reset pointer since we destroyed the texture
@@ -867,8 +866,8 @@ void GStreamerVideo::createSdlTexture() {
 		textureValid_.store(false, std::memory_order_release);
 
 		// Create YUV texture for video
-		videoTexture_ = SDL_CreateTexture(
-			SDL::getRenderer(monitor_), sdlFormat_,
+		videoTexture_ = TextureRegistry::create(
+			SDL::getRenderer(monitor_), TextureRegistry::OwnerVideo, monitor_, sdlFormat_,
 			SDL_TEXTUREACCESS_STREAMING, newWidth, newHeight);
 
 		if (!videoTexture_) {
@@ -879,6 +878,7 @@ void GStreamerVideo::createSdlTexture() {
 
 		SDL_BlendMode blendMode = softOverlay_ ? softOverlayBlendMode : SDL_BLENDMODE_BLEND;
 		SDL_SetTextureBlendMode(videoTexture_, blendMode);
+		SDL::invalidate(videoTexture_);
 
 
 		texture_ = videoTexture_;  // Start pointing to video texture
@@ -1044,6 +1044,9 @@ void GStreamerVideo::draw() {
 			// Mark texture as invalid so we'll try to recreate it next frame
 			textureValid_.store(false, std::memory_order_release);
 		}
+		else {
+			SDL::invalidate(texture_);
+		}
 	}
 
 	// We're done with SDL operations, unlock the mutex